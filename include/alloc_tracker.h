@@ -0,0 +1,38 @@
+/*
+ * File: alloc_tracker.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: AllocTracker class header, counts heap allocations made through operator new.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Allocation counters fed by the global operator new/delete in alloc_hooks.cpp.
+ * Only targets that link alloc_hooks.cpp are counted, everywhere else the
+ * counters stay at zero and isEnabled() is false.
+ * Totals cover every thread, the thread counts only the calling thread so
+ * a timed zone isn't charged for the allocations of others.
+ */
+class AllocTracker {
+public:
+    struct Counts {
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+        std::uint64_t frees;
+    };
+
+    static bool isEnabled() { return enabled; }
+    static Counts getTotal();
+    static Counts getThread();
+
+    // Called from the hooks only
+    static bool enable();
+    static void recordAllocation(std::size_t bytes);
+    static void recordFree();
+
+private:
+    static bool enabled;
+};
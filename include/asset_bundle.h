@@ -0,0 +1,88 @@
+/*
+ * File: asset_bundle.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: AssetBundle and AssetBundleWriter classes header, every asset
+ * baked ahead of time into one file that the game maps into memory.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Bundle layout, numbers in the byte order of the machine that baked it:
+ *   "PMAB", version, entry count, then one Entry per asset
+ *   each asset's bytes, starting on a 16 byte boundary
+ * Images are raw RGBA pixels already at the size they're drawn at, so
+ * loading one is handing the mapped bytes to the GPU. Anything else (fonts)
+ * is the file as it was. Assets are found by the path the game would have
+ * loaded them from.
+ * The file is mapped rather than read, so only the pages actually used are
+ * touched, and the data stays valid until the bundle is closed.
+ */
+class AssetBundle {
+public:
+    static const std::size_t NAME_SIZE = 48;
+    struct Entry {
+        char name[NAME_SIZE];
+        // 0 for assets that aren't images
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    static const char MAGIC[4];
+    static const std::uint32_t VERSION;
+
+    AssetBundle();
+    ~AssetBundle();
+    AssetBundle(const AssetBundle&) = delete;
+    AssetBundle& operator=(const AssetBundle&) = delete;
+
+    int open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    // nullptr if the bundle has no asset of that name
+    const Entry* find(const std::string& name) const;
+    const std::uint8_t* getData(const Entry& entry) const { return data + entry.offset; }
+    std::size_t getEntryCount() const { return entryCount; }
+    std::size_t getSize() const { return size; }
+
+    // Box filtered resize of RGBA pixels, weighting colors by alpha so transparent edges don't darken
+    static void downsample(const std::uint8_t* pixels, unsigned width, unsigned height, unsigned newWidth,
+                           unsigned newHeight, std::vector<std::uint8_t>& resized);
+
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+    const Entry* entries;
+    std::size_t entryCount;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+
+    bool validate();
+};
+
+/**
+ * Gathers assets for the asset baker, then writes them out as a bundle
+ */
+class AssetBundleWriter {
+public:
+    void addImage(const std::string& name, unsigned width, unsigned height, const std::uint8_t* pixels);
+    void addFile(const std::string& name, const std::vector<std::uint8_t>& bytes);
+    int write(const std::string& path) const;
+
+private:
+    std::vector<AssetBundle::Entry> entries;
+    // every asset's bytes, each padded to the alignment
+    std::vector<std::uint8_t> blob;
+
+    void add(const std::string& name, unsigned width, unsigned height, const std::uint8_t* bytes, std::size_t count);
+};
@@ -0,0 +1,93 @@
+/*
+ * File: batch_runner.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: BatchRunner class header, plays many headless games in parallel
+ * and sums up how they went, for balance tuning.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "game_sim.h"
+#include "rng.h"
+
+class JobSystem;
+
+/**
+ * Stands in for the player, picking the held directions every tick
+ */
+class InputPolicy {
+public:
+    enum Kind {
+        RANDOM, // holds a random direction for a random while
+        CHASE   // heads for the closest ghost, wandering when there is none
+    };
+
+    InputPolicy(Kind kind, std::uint64_t seed);
+    std::uint8_t next(const GameSim& sim);
+
+private:
+    static const int MIN_HOLD_TICKS;
+    static const int MAX_HOLD_TICKS;
+
+    Kind kind;
+    Rng rng;
+    std::uint8_t held;
+    int holdTicks;
+
+    std::uint8_t wander();
+    std::uint8_t chase(const GameSim& sim);
+};
+
+// How one game went
+struct GameResult {
+    std::uint64_t seed;
+    int score;
+    int ghostsEaten;
+    // fraction of the game played with the speed boost on
+    float boostUptime;
+};
+
+// Aggregate of a whole batch
+struct BatchStats {
+    std::size_t games = 0;
+    double meanScore = 0;
+    double scoreStdDev = 0;
+    int minScore = 0;
+    int p10Score = 0;
+    int medianScore = 0;
+    int p90Score = 0;
+    int maxScore = 0;
+    double meanGhostsEaten = 0;
+    int maxGhostsEaten = 0;
+    double meanBoostUptime = 0;
+    // games per score bucket, bucket i holding scores in [i * width, (i + 1) * width)
+    int histogramBucketWidth = 1;
+    std::vector<std::size_t> histogram;
+};
+
+/**
+ * Plays N independent games across every core. Game i always gets the same
+ * seed for a given batch seed, so a batch gives the same results whatever
+ * the number of threads.
+ */
+class BatchRunner {
+public:
+    BatchRunner(const SimConfig& config, InputPolicy::Kind policy);
+
+    const std::vector<GameResult>& run(std::size_t games, std::uint64_t batchSeed, JobSystem& jobs);
+    const std::vector<GameResult>& getResults() const { return results; }
+
+    static std::uint64_t gameSeed(std::uint64_t batchSeed, std::size_t game);
+    static GameResult playGame(std::uint64_t seed, const SimConfig& config, InputPolicy::Kind policy);
+    static BatchStats summarize(const std::vector<GameResult>& results, std::size_t histogramBuckets = 20);
+
+private:
+    static const std::size_t CHUNKS_PER_THREAD;
+
+    SimConfig config;
+    InputPolicy::Kind policy;
+    std::vector<GameResult> results;
+};
@@ -0,0 +1,38 @@
+/*
+ * File: chunked_background.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ChunkedBackground class header, the world's background tiles built
+ * once into one vertex array per chunk, and only the chunks in view drawn.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * The background tile repeated over the whole world. Tiles are grouped into
+ * square chunks of CHUNK_TILES x CHUNK_TILES, each kept as its own vertex
+ * array built once, so a frame only walks and draws the few chunks the view
+ * overlaps whatever the size of the world.
+ */
+class ChunkedBackground {
+public:
+    static const int CHUNK_TILES;
+
+    ChunkedBackground();
+    // tile is drawn at its own size, the world's edge cuts the last row and column of tiles
+    int build(const sf::Texture& tile, const sf::Vector2f& worldSize);
+    // returns how many chunks were drawn
+    std::size_t draw(sf::RenderTarget& target, const sf::FloatRect& visible) const;
+
+    std::size_t getChunkCount() const { return chunks.size(); }
+
+private:
+    const sf::Texture* texture;
+    sf::Vector2f chunkSize;
+    int columns;
+    int rows;
+    std::vector<sf::VertexArray> chunks;
+};
@@ -0,0 +1,39 @@
+/*
+ * File: collision.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Collision class header, batch circle tests over packed positions.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Tests a point against many entities at once, comparing squared distances so
+ * there is no sqrt in the loop. The widest instruction set the CPU supports is
+ * picked the first time it's used.
+ */
+class Collision {
+public:
+    enum Backend { SCALAR, SSE, AVX2 };
+
+    // Writes the index of every entity closer than radius to (x, y) into hits,
+    // in increasing order, and returns how many there are.
+    // hits must have room for count indices.
+    static std::size_t findHits(const float* xs, const float* ys, std::size_t count,
+                                float x, float y, float radius, std::uint32_t* hits);
+    static std::size_t findHits(Backend backend, const float* xs, const float* ys, std::size_t count,
+                                float x, float y, float radius, std::uint32_t* hits);
+
+    static Backend getBackend();
+    static bool isSupported(Backend backend);
+
+private:
+    static std::size_t findHitsScalar(const float* xs, const float* ys, std::size_t begin, std::size_t count,
+                                      float x, float y, float radiusSq, std::uint32_t* hits);
+    static std::size_t findHitsSse(const float* xs, const float* ys, std::size_t count,
+                                   float x, float y, float radiusSq, std::uint32_t* hits);
+    static std::size_t findHitsAvx2(const float* xs, const float* ys, std::size_t count,
+                                    float x, float y, float radiusSq, std::uint32_t* hits);
+};
@@ -0,0 +1,113 @@
+/*
+ * File: entity.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Entity template, the rules every kind of entity shares, specialized
+ * at compile time by a traits struct per kind.
+ */
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "rng.h"
+#include "spatial_grid.h"
+
+/**
+ * Traits of each kind of entity. A kind gives its hitbox, how far from the
+ * player and the scene edges it spawns, how many tries a spawn gets before it
+ * may overlap, how many pixels it moves per tick, and the looks the renderer
+ * picks a texture by. Adding a kind means adding a traits struct here.
+ */
+struct GhostTraits {
+    enum Color { BLUE, ORANGE, PINK, RED, COLOR_COUNT };
+    using Look = Color;
+
+    static constexpr int LOOK_COUNT = COLOR_COUNT;
+    static constexpr float HITBOX = 40.0f;
+    static constexpr float MIN_SPAWN_DISTANCE = 150.0f;
+    static constexpr float SPAWN_MARGIN = 20.0f;
+    static constexpr int MAX_SPAWN_ATTEMPTS = 64;
+    static constexpr float SPEED = 1.0f;
+};
+
+struct FruitTraits {
+    enum Kind { CHERRY, MELON, BERRY, KIND_COUNT };
+    using Look = Kind;
+
+    static constexpr int LOOK_COUNT = KIND_COUNT;
+    static constexpr float HITBOX = 30.0f;
+    static constexpr float MIN_SPAWN_DISTANCE = 150.0f;
+    static constexpr float SPAWN_MARGIN = 20.0f;
+    static constexpr int MAX_SPAWN_ATTEMPTS = 64;
+    static constexpr float SPEED = 0.0f;
+};
+
+/**
+ * Rules shared by every entity of a kind, with the kind's constants known at
+ * compile time so each kind gets its own fully inlined code and nothing
+ * branches on the kind at run time. The traits' names (Ghost::BLUE,
+ * Fruit::Kind, ...) are reachable through Entity<Traits>.
+ * Per-entity state lives in the owner's store, not here.
+ */
+template <typename Traits>
+class Entity : public Traits {
+public:
+    using Look = typename Traits::Look;
+
+    static constexpr float getHitbox() { return Traits::HITBOX; }
+
+    static Look randLook(Rng& rng) {
+        return static_cast<Look>(rng.uniformInt(0, Traits::LOOK_COUNT - 1));
+    }
+
+    /**
+     * Move one tick in the given direction, keeping a hitbox away from the scene edges
+     */
+    static void step(float& x, float& y, float dirX, float dirY, const sf::Vector2f& scene) {
+        x = std::min(std::max(x + dirX * Traits::SPEED, getHitbox()), scene.x - getHitbox());
+        y = std::min(std::max(y + dirY * Traits::SPEED, getHitbox()), scene.y - getHitbox());
+    }
+
+    /**
+     * Generate a random spawn position, away from the player and not
+     * overlapping ghosts or fruits
+     * @return the spawn position
+     */
+    static sf::Vector2f randSpawn(const sf::Vector2f& playerPosition, const sf::Vector2f& scene, Rng& rng,
+                                  const SpatialGrid& ghostGrid, const SpatialGrid& fruitGrid) {
+        return randSpawn(&playerPosition, 1, scene, rng, ghostGrid, fruitGrid);
+    }
+    /**
+     * Same, away from every one of several players
+     */
+    static sf::Vector2f randSpawn(const sf::Vector2f* playerPositions, std::size_t playerCount,
+                                  const sf::Vector2f& scene, Rng& rng, const SpatialGrid& ghostGrid,
+                                  const SpatialGrid& fruitGrid) {
+        sf::Vector2f spawnPosition;
+        float distance;
+        bool clear = false;
+        int attempts = 0;
+        do {
+            spawnPosition.x = rng.uniform(Traits::SPAWN_MARGIN, scene.x - Traits::SPAWN_MARGIN);
+            spawnPosition.y = rng.uniform(Traits::SPAWN_MARGIN, scene.y - Traits::SPAWN_MARGIN);
+            // Distance to the nearest player
+            distance = std::numeric_limits<float>::max();
+            for (std::size_t i = 0; i < playerCount; ++i) {
+                distance = std::min(distance, static_cast<float>(std::sqrt(
+                        std::pow(spawnPosition.x - playerPositions[i].x, 2) +
+                        std::pow(spawnPosition.y - playerPositions[i].y, 2))));
+            }
+            // Overlapping is only accepted once the scene is too crowded to find a free spot
+            if (distance >= Traits::MIN_SPAWN_DISTANCE) {
+                clear = ++attempts > Traits::MAX_SPAWN_ATTEMPTS ||
+                        (!ghostGrid.anyWithin(spawnPosition, Traits::HITBOX + GhostTraits::HITBOX) &&
+                         !fruitGrid.anyWithin(spawnPosition, Traits::HITBOX + FruitTraits::HITBOX));
+            }
+        } while (distance < Traits::MIN_SPAWN_DISTANCE || !clear);
+
+        return spawnPosition;
+    }
+};
@@ -0,0 +1,70 @@
+/*
+ * File: flow_field.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: FlowField class header, grid distance field toward a target
+ * shared by every ghost for navigation.
+ */
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Distance in cells from every cell of the world to the nearest cell holding
+ * a target, along with the step that gets closer to it and the one that gets
+ * further away. It is rebuilt only when a target changes cell, and any
+ * number of readers then get their step in O(1) by looking up their own cell.
+ * Reading is const, so readers can run on several threads between updates.
+ */
+class FlowField {
+public:
+    // one cell along an axis, STAY once there is nowhere better to go
+    enum Step : std::uint8_t { STAY, UP, DOWN, LEFT, RIGHT };
+
+    FlowField(float width, float height, float cellSize);
+    // returns true if a target changed cell and the field was rebuilt
+    bool update(const sf::Vector2f& target) { return update(&target, 1); }
+    bool update(const sf::Vector2f* targets, std::size_t count);
+
+    Step getToward(float x, float y) const { return toward[cellIndex(x, y)]; }
+    Step getAway(float x, float y) const { return away[cellIndex(x, y)]; }
+    // cells between a position and the nearest target, moving along the axes
+    std::uint16_t getDistance(const sf::Vector2f& position) const { return distance[cellIndex(position.x, position.y)]; }
+    std::size_t getCellCount() const { return distance.size(); }
+
+    static float getStepX(Step step) { return STEP_X[step]; }
+    static float getStepY(Step step) { return STEP_Y[step]; }
+
+private:
+    static const float STEP_X[5];
+    static const float STEP_Y[5];
+
+    // multiplied by instead of dividing, on every lookup
+    float inverseCellSize;
+    int columns;
+    int rows;
+    // cells the field was last built for, none before the first update, and their columns and rows
+    std::vector<std::uint32_t> targetCells;
+    std::vector<int> targetColumns;
+    std::vector<int> targetRows;
+    std::vector<std::uint16_t> distance;
+    // target each cell is nearest to, as an index into targetCells
+    std::vector<std::uint32_t> nearest;
+    std::vector<Step> toward;
+    std::vector<Step> away;
+    // breadth-first search queue of cells as column | row << 16, sized for every cell up front
+    std::vector<std::uint32_t> frontier;
+
+    int column(float x) const { return std::min(std::max(static_cast<int>(x * inverseCellSize), 0), columns - 1); }
+    int row(float y) const { return std::min(std::max(static_cast<int>(y * inverseCellSize), 0), rows - 1); }
+    std::uint32_t cellIndex(float x, float y) const {
+        return static_cast<std::uint32_t>(row(y) * columns + column(x));
+    }
+    void rebuild();
+    void pickSteps(int cell, int x, int y);
+    Step furthestNeighbor(int cell, int x, int y, bool horizontalFirst) const;
+};
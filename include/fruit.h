@@ -6,26 +6,22 @@
  */
 
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "entity.h"
+#include "rng.h"
 
-class Fruit {
+/**
+ * One fruit, its hitbox and spawning rules come from the fruit kind of Entity
+ */
+class Fruit : public Entity<FruitTraits> {
 public:
-    explicit Fruit(const sf::Vector2f& playerPosition);
-    const sf::CircleShape& getFruit() const { return fruit; }
+    // empty slot for a pool, overwritten before use
+    Fruit() : kind(CHERRY) {}
+    Fruit(const sf::Vector2f& spawnPosition, Rng& rng) : position(spawnPosition), kind(randLook(rng)) {}
+    const sf::Vector2f& getPosition() const { return position; }
+    Kind getKind() const { return kind; }
 
 private:
-    static const float HITBOX;
-    static const float MIN_SPAWN_DISTANCE;
-    static const float MAX_SPAWN_DISTANCE_X;
-    static const float MAX_SPAWN_DISTANCE_Y;
-
-    static sf::Texture cherryTexture;
-    static sf::Texture melonTexture;
-    static sf::Texture berryTexture;
-    sf::CircleShape fruit;
-
-    int loadTextures();
-    void assignRandomTexture();
-    int initFruit(const sf::Vector2f& spawnPosition);
-    static sf::Vector2f randSpawn(const sf::Vector2f& playerPosition);
-};
\ No newline at end of file
+    sf::Vector2f position;
+    Kind kind;
+};
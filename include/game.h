@@ -8,83 +8,123 @@
 
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <SFML/System/Clock.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
-#include "ghost.h"
-#include "fruit.h"
+#include "chunked_background.h"
+#include "game_sim.h"
+#include "hud.h"
+#include "input_queue.h"
+#include "job_system.h"
+#include "net_client.h"
+#include "profiler.h"
+#include "profiler_overlay.h"
+#include "replay.h"
+#include "resource_manager.h"
+#include "rewind_buffer.h"
+#include "save_state.h"
+#include "snapshot.h"
+#include "sprite_batch.h"
+#include "time_source.h"
+#include "triple_buffer.h"
 
+/**
+ * The window and the simulation, each on its own thread. The simulation
+ * thread ticks at the fixed tick rate and publishes a snapshot after each
+ * batch of ticks; the window thread handles events and draws the latest
+ * snapshot as fast as the display takes frames. Neither waits for the other.
+ * Holding Backspace steps the game back a tick at a time, Enter starts a new
+ * game from the saved starting state, both without leaving the window.
+ * Playing on a server, the simulation thread trades inputs and states with
+ * it instead of ticking the local game, which then only gives the world's size.
+ */
 class Game {
-    friend class GameTest;
-
 public:
-    Game();
+    explicit Game(const SimConfig& config = SimConfig());
+    Game(std::unique_ptr<TimeSource> timeSource, const SimConfig& config);
+    ~Game();
     int run();
-    static float getSceneWidth() { return SCENE_WIDTH; }
-    static float getSceneHeight() { return SCENE_HEIGHT; }
-    static float getMaxGhosts() { return MAX_GHOSTS; }
-    static float getMaxFruits() { return MAX_FRUITS; }
+    // Write the seed and every tick's input to a replay file while playing
+    int startRecording(const std::string& path);
+    // Play on a server that already welcomed the client, before run()
+    void playOnServer(std::unique_ptr<NetClient> client);
+    static float getSceneWidth() { return GameSim::getSceneWidth(); }
+    static float getSceneHeight() { return GameSim::getSceneHeight(); }
 
-    std::vector<Ghost> getGhosts() { return ghosts; }
-    sf::Clock getGhostSpawnClock() { return ghostSpawnClock; }
-    float getNextSpawnTime() { return nextSpawnTime; }
+private:
+    // Longest stall the simulation catches up on, so it doesn't snowball into more ticks
+    static const sf::Time MAX_FRAME_TIME;
+    // How far back rewinding goes
+    static const std::size_t REWIND_TICKS;
 
-    std::vector<Fruit> getFruits() { return fruits; }
-    sf::Clock getFruitSpawnClock() { return fruitSpawnClock; }
-    float getNextFruitSpawnTime() { return nextFruitSpawnTime; }
+    // Runs from construction, for the time to the first frame
+    sf::Clock startupClock;
+    // Owned by the simulation thread once run() starts it
+    JobSystem jobs;
+    GameSim sim;
+    std::unique_ptr<TimeSource> timeSource;
+    ReplayWriter recorder;
+    // one state per tick played, rewinding restores them newest first
+    RewindBuffer rewind;
+    // the game before its first tick, restarting restores it with a new seed
+    SaveState startState;
+    // set when playing on a server
+    std::unique_ptr<NetClient> server;
 
-
-private:
-    static const float SCENE_WIDTH;
-    static const float SCENE_HEIGHT;
-    static const float PLAYER_START_X;
-    static const float PLAYER_START_Y;
-    static const float RADIUS;
-    static const int MAX_GHOSTS;
-    static const int MAX_FRUITS;
-    static const float COLLISION_THRESHOLD;
-    static const float BASE_P_SPEED;
-    static const float BOOSTED_P_SPEED;
+    std::thread simThread;
+    std::atomic<bool> simRunning{false};
+    // direction key changes, from the window thread to the tick they happen at
+    InputQueue input;
+    TripleBuffer<Snapshot> snapshots;
+    // set by the window thread, acted on by the simulation thread at its next tick
+    std::atomic<bool> rewinding{false};
+    std::atomic<bool> restartRequested{false};
 
     sf::RenderWindow window;
-    sf::Sprite background;
-    sf::Texture backgroundTexture;
+    // one screen of the world, centered on the player
+    sf::View camera;
+    ResourceManager resources;
+    bool resourcesLoaded = false;
+    ChunkedBackground background;
+    sf::CircleShape player;
+    // the other players of a shared game
+    sf::CircleShape rival;
+    // window thread, time from sending an input to showing the server state that applied it
+    std::vector<sf::Time> serverLatencies;
+    std::size_t serverLatencyCount = 0;
+    std::uint32_t lastServerTick = 0;
+    Hud hud;
 
-    sf::Clock gameClock;
-    sf::Time totalTime;
-    sf::Text countdownText;
-    sf::Text finalScoreText;
+    // Ghosts and fruits are all drawn in one batch from the resource atlas
+    SpriteBatch entityBatch;
 
-    sf::Font font;
-    sf::Text scoreText;
-    sf::Texture playerTexture;
-    sf::CircleShape player;
-    sf::Time speedBoostEndTime;
-    sf::Clock speedClock;
-    sf::Text speedBoostText;
-    std::vector<Ghost> ghosts;
-    sf::Clock ghostSpawnClock;
-    std::vector<Fruit> fruits;
-    sf::Clock fruitSpawnClock;
+#ifdef GAME_PROFILING
+    // F3 shows the zone times, F4 writes the last zones to TRACE_PATH
+    static const char* const TRACE_PATH;
+    ProfilerOverlay profilerOverlay;
+    bool showProfiler = true;
+#endif
 
     int initWindow();
+    int initResources();
     int initBackground();
-    int initScore();
+    int initHud();
     int initPlayer();
     void processInput();
-    int displaySpeedText();
-    int score;
-    float nextSpawnTime;
-    float nextFruitSpawnTime{};
-    bool gameEnded;
+    static std::uint8_t keyDirection(sf::Keyboard::Key key);
+    void reportLatency() const;
+    void reportStartup() const;
 
-    void update();
-    int clockRender();
-    int finalScoreRender();
-    float randSpawnDelay(int type);
-    void checkObjNum();
-    void checkCollisions();
-    void checkFruitCollisions();
-    float pSpeed();
+    void startSimulation();
+    void stopSimulation();
+    void simulate();
+    void restart();
+    void stopRecording();
 
     void render();
-};
\ No newline at end of file
+    void followPlayer(const sf::Vector2f& position);
+    static bool isVisible(const sf::FloatRect& visible, const sf::Vector2f& position, float halfSize);
+    static sf::Vector2f interpolate(const sf::Vector2f& previous, const sf::Vector2f& current, float alpha);
+};
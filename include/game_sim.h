@@ -0,0 +1,203 @@
+/*
+ * File: game_sim.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: GameSim class header, window-free simulation core of the game.
+ */
+
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "ghost.h"
+#include "flow_field.h"
+#include "fruit.h"
+#include "pool.h"
+#include "rng.h"
+#include "save_state.h"
+#include "spatial_grid.h"
+#include "timer_wheel.h"
+
+class JobSystem;
+
+/**
+ * Balance knobs of a game, the defaults being the shipped game
+ */
+struct SimConfig {
+    int maxGhosts = 10;
+    int maxFruits = 3;
+    // seconds between two spawns, picked uniformly in [min, max)
+    float ghostSpawnDelayMin = 0.0f;
+    float ghostSpawnDelayMax = 1.5f;
+    float fruitSpawnDelayMin = 5.0f;
+    float fruitSpawnDelayMax = 9.0f;
+    // pixels per tick
+    float basePlayerSpeed = 5.0f;
+    float boostedPlayerSpeed = 8.0f;
+    sf::Time boostDuration = sf::seconds(3);
+    sf::Time totalTime = sf::seconds(23);
+    // the playfield is this many screens wide and high, the camera follows the player around it
+    int worldScale = 1;
+    // pacmen competing for the same ghosts and fruits, each with their own input, score and boost
+    int players = 1;
+    // how ghosts of each color move, indexed by Ghost::Color. All of them wander in the shipped game.
+    GhostBehavior ghostBehaviors[Ghost::COLOR_COUNT] = {GHOST_WANDER, GHOST_WANDER, GHOST_WANDER, GHOST_WANDER};
+};
+
+// Directions held by the player during a tick, OR'd together
+enum Input : std::uint8_t {
+    INPUT_NONE = 0,
+    INPUT_UP = 1 << 0,
+    INPUT_DOWN = 1 << 1,
+    INPUT_LEFT = 1 << 2,
+    INPUT_RIGHT = 1 << 3
+};
+
+class GameSim {
+    friend class GameTest;
+    friend class GameBenchmark;
+
+public:
+    explicit GameSim(std::uint64_t seed = Rng::randomSeed(), const SimConfig& config = SimConfig());
+    void tick();
+    void advance(sf::Time duration);
+    // Without a player index, these are about the first player
+    void setInput(std::uint8_t newInput, std::size_t player = 0) { players[player].input = newInput; }
+    std::uint8_t getInput(std::size_t player = 0) const { return players[player].input; }
+    // Spread the ghost updates over a thread pool, nullptr to run them all on the calling thread
+    void setJobSystem(JobSystem* newJobs) { jobs = newJobs; }
+
+    // Everything that changes as the game plays, restorable into a sim made with the same config
+    void save(SaveState& state) const;
+    int restore(const SaveState& state);
+    // room for a save with as many ghosts as the config allows
+    std::size_t getMaxSaveSize() const;
+    // random decisions from now on come from a new seed, for a new game from a restored start
+    void reseed(std::uint64_t newSeed);
+
+    // The simulation always steps by this fixed amount of game time
+    static sf::Time getTickTime() { return sf::microseconds(1000000 / TICK_RATE); }
+    sf::Time getTime() const { return sf::microseconds(static_cast<std::int64_t>(tickCount) * 1000000 / TICK_RATE); }
+
+    // What one screen shows of the world
+    static float getSceneWidth() { return SCENE_WIDTH; }
+    static float getSceneHeight() { return SCENE_HEIGHT; }
+    static sf::Vector2f getSceneSize() { return {SCENE_WIDTH, SCENE_HEIGHT}; }
+    const sf::Vector2f& getWorldSize() const { return worldSize; }
+    static float getPlayerRadius() { return RADIUS; }
+    // One tick of a player's movement, shared with network clients predicting their own player
+    static sf::Vector2f movePlayer(const sf::Vector2f& position, std::uint8_t input, float speed,
+                                   const sf::Vector2f& world);
+    const SimConfig& getConfig() const { return config; }
+    int getMaxGhosts() const { return config.maxGhosts; }
+    int getMaxFruits() const { return config.maxFruits; }
+
+    std::size_t getPlayerCount() const { return playerPositions.size(); }
+    const sf::Vector2f& getPlayerPosition(std::size_t player = 0) const { return playerPositions[player]; }
+    const sf::Vector2f& getPreviousPlayerPosition(std::size_t player = 0) const {
+        return previousPlayerPositions[player];
+    }
+    std::uint64_t getSeed() const { return seed; }
+    int getScore(std::size_t player = 0) const { return players[player].score; }
+    int getGhostsEaten(std::size_t player = 0) const { return players[player].ghostsEaten; }
+    // ticks played with the speed boost on
+    std::uint32_t getBoostedTicks(std::size_t player = 0) const { return players[player].boostedTicks; }
+    std::uint32_t getTickCount() const { return tickCount; }
+    bool isGameEnded() const { return gameEnded; }
+    sf::Time getTimeLeft() const;
+    bool isSpeedBoosted(std::size_t player = 0) const { return players[player].speedBoosted; }
+    // pixels per tick the player moves at right now
+    float getPlayerSpeed(std::size_t player = 0) const;
+
+    const GhostStore& getGhosts() const { return ghosts; }
+    float getNextSpawnTime() { return nextSpawnTime; }
+
+    // fruits in use, their slot being their id in the fruit grid
+    const Pool<Fruit>& getFruits() const { return fruits; }
+    const SpatialGrid& getGhostGrid() const { return ghostGrid; }
+    const SpatialGrid& getFruitGrid() const { return fruitGrid; }
+    // toward the player, kept up to date only when some color chases or flees
+    const FlowField& getPlayerField() const { return playerField; }
+    float getNextFruitSpawnTime() { return nextFruitSpawnTime; }
+
+private:
+    static const int TICK_RATE;
+    static const float SCENE_WIDTH;
+    static const float SCENE_HEIGHT;
+    static const float RADIUS;
+    static const float DIAGONAL_SCALE;
+    static const float COLLISION_THRESHOLD;
+    static const float GRID_CELL_SIZE;
+    static const std::size_t GHOST_CHUNK_SIZE;
+
+    // Everything that happens at a given time rather than every tick
+    enum TimerType : std::uint8_t {
+        GAME_OVER,
+        GHOST_SPAWN,
+        FRUIT_SPAWN,
+        BOOST_END, // target is the player
+        GHOST_TURN // target is the ghost's id
+    };
+
+    std::uint64_t seed;
+    SimConfig config;
+    sf::Vector2f worldSize;
+    Rng rng;
+    JobSystem* jobs;
+
+    // What each player has of their own. Positions are kept apart, packed for
+    // spawn checks and the flow field.
+    struct Player {
+        std::uint8_t input;
+        bool speedBoosted;
+        // bumped on every boost, so only the latest boost's BOOST_END ends it
+        std::uint32_t boostGeneration;
+        std::uint32_t boostedTicks;
+        int score;
+        int ghostsEaten;
+    };
+    std::vector<sf::Vector2f> playerPositions;
+    std::vector<sf::Vector2f> previousPlayerPositions;
+    std::vector<Player> players;
+
+    std::uint32_t tickCount;
+    TimerWheel timers;
+    GhostStore ghosts;
+    Pool<Fruit> fruits;
+    // a spawn came due while full, it happens as soon as there's room
+    bool ghostSpawnWaiting;
+    bool fruitSpawnWaiting;
+    // where every ghost and fruit is, ids being their index
+    SpatialGrid ghostGrid;
+    SpatialGrid fruitGrid;
+    // cells of the same size as the grids, rebuilt when the player changes cell
+    FlowField playerField;
+    // some color chases or flees, otherwise nothing reads the field and it's never rebuilt
+    bool fieldFollowed;
+
+    // scratch space for collision queries, sized for every ghost and fruit
+    std::vector<std::uint32_t> hits;
+
+    float nextSpawnTime;
+    float nextFruitSpawnTime{};
+    bool gameEnded;
+
+    static std::uint32_t ticksFor(float seconds);
+    void schedule(TimerType type, std::uint32_t ticks, std::uint32_t target = 0, std::uint32_t generation = 0);
+    void runTimers();
+    void fireTimer(const TimerWheel::Timer& timer);
+    void endGame();
+
+    void update();
+    float randSpawnDelay(int type);
+    void spawnGhost();
+    void spawnFruit();
+    void scheduleTurn(std::size_t index);
+    void updatePlayerField();
+    void updateGhosts();
+    void removeGhost(std::size_t index);
+    void removeFruit(std::uint32_t slot);
+    void checkCollisions();
+    void checkFruitCollisions();
+};
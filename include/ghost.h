@@ -6,45 +6,106 @@
  */
 
 #pragma once
-#include <SFML/Graphics.hpp>
-#include <random>
-#include <cmath>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "entity.h"
+#include "flow_field.h"
+#include "rng.h"
+#include "save_state.h"
 
-class Ghost {
+// Constants and spawning rules shared by every ghost, the per-ghost state lives in GhostStore
+using Ghost = Entity<GhostTraits>;
+
+// How a ghost picks its direction
+enum GhostBehavior : std::uint8_t {
+    GHOST_WANDER, // a random direction on every turn()
+    GHOST_CHASE, // toward the flow field's target, every tick
+    GHOST_FLEE // away from it
+};
+
+/**
+ * Every ghost in the game, one tightly packed array per field so the per-tick
+ * loops only touch the fields they need. Removing a ghost moves the last one
+ * into its slot, so indices are not stable across remove(); ids are, and an
+ * id's generation changes once its ghost is removed.
+ * Moving one ghost only touches that ghost's slots, so disjoint ranges can
+ * be moved from different threads. When a wandering ghost turns is up to the
+ * owner, chasing and fleeing ones read their direction from a shared flow
+ * field on every move instead.
+ */
+class GhostStore {
 public:
-    explicit Ghost(const sf::Vector2f& playerPosition);
-    const sf::CircleShape& getGhost() { return ghost; }
-    static float getHitbox() { return HITBOX; }
+    GhostStore();
+    // ghosts keep a hitbox away from the edges of the world, one screen by default
+    void setBounds(const sf::Vector2f& size) { bounds = size; }
+    // behavior of the ghosts added from now on, by color, every color wanders by default
+    void setBehaviors(const GhostBehavior (&byColor)[Ghost::COLOR_COUNT]);
+    void reserve(std::size_t capacity);
+    std::size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+
+    // the new ghost stands still until its first turn()
+    std::size_t add(const sf::Vector2f& position, sf::Time now, Rng& rng);
+    void remove(std::size_t index);
+    void clear();
+    // every ghost and id, the bounds and behaviors by color are the owner's to set up again
+    void save(SaveState& state) const;
+    void restore(const SaveState& state, std::size_t& offset);
+    // most bytes save() writes per ghost, on top of a fixed amount for the array lengths
+    static std::size_t getSavedBytesPerGhost();
+
+    // returns the seconds until the ghost should turn again
+    float turn(std::size_t index);
+    // chasing and fleeing ghosts stand still without a field
+    void updateMovement(const FlowField* field = nullptr);
+    void updateMovement(std::size_t begin, std::size_t end, const FlowField* field = nullptr);
+    void updateMovement(std::size_t index, const FlowField* field = nullptr);
 
-    void updateMovement();
+    std::uint32_t getId(std::size_t index) const { return ids[index]; }
+    std::uint32_t getGeneration(std::uint32_t id) const { return idGeneration[id]; }
+    // returns false if the ghost with that id and generation is gone
+    bool findIndex(std::uint32_t id, std::uint32_t generation, std::size_t& index) const;
+
+    // packed coordinates of every ghost, for batch collision tests
+    const float* getXs() const { return posX.data(); }
+    const float* getYs() const { return posY.data(); }
+
+    sf::Vector2f getPosition(std::size_t index) const { return {posX[index], posY[index]}; }
+    sf::Vector2f getPreviousPosition(std::size_t index) const { return {prevX[index], prevY[index]}; }
+    Ghost::Color getColor(std::size_t index) const { return static_cast<Ghost::Color>(color[index]); }
+    GhostBehavior getBehavior(std::size_t index) const { return static_cast<GhostBehavior>(behavior[index]); }
     // returns how long the ghost has lived
-    float ghostLifeExpectancy() const {
-        return spawnClock.getElapsedTime().asSeconds();
+    float ghostLifeExpectancy(std::size_t index, sf::Time now) const {
+        return (now - spawnTime[index]).asSeconds();
     }
 
     // Test case functions
-    void setPosition(const sf::Vector2f& position);
-    sf::Vector2f getPosition();
+    void setPosition(std::size_t index, const sf::Vector2f& position);
 
 private:
-    static const float HITBOX;
-    static const float MIN_SPAWN_DISTANCE;
-    static const float MAX_SPAWN_DISTANCE_X;
-    static const float MAX_SPAWN_DISTANCE_Y;
-
-    static sf::Texture blueTexture;
-    static sf::Texture orangeTexture;
-    static sf::Texture pinkTexture;
-    static sf::Texture redTexture;
-    sf::CircleShape ghost;
-    sf::Clock spawnClock;
-    sf::Vector2f direction;
-    sf::Clock movementClock;
-    float movementInterval;
-
-    int loadTextures();
-    void assignRandomTexture();
-    int initGhost(const sf::Vector2f& spawnPosition);
-    static sf::Vector2f randSpawn(const sf::Vector2f& playerPosition);
-    void decideNextMovement();
-};
\ No newline at end of file
+    sf::Vector2f bounds;
+    GhostBehavior behaviorByColor[Ghost::COLOR_COUNT];
+    std::vector<float> posX;
+    std::vector<float> posY;
+    // position one tick ago, for render interpolation
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+    std::vector<float> dirX;
+    std::vector<float> dirY;
+    std::vector<sf::Time> spawnTime;
+    std::vector<std::uint8_t> color;
+    std::vector<std::uint8_t> behavior;
+    // own stream for direction changes, so ghosts don't depend on each other's rolls
+    std::vector<Rng> movementRng;
+    std::vector<std::uint32_t> ids;
+
+    // by id, where the ghost is and how many ghosts had the id before it
+    std::vector<std::uint32_t> idIndex;
+    std::vector<std::uint32_t> idGeneration;
+    std::vector<std::uint32_t> freeIds;
+
+    void releaseId(std::uint32_t id);
+};
@@ -0,0 +1,56 @@
+/*
+ * File: hud.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Hud class header, score, countdown, speed boost and game over texts.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include "snapshot.h"
+
+/**
+ * A line of text showing one number, like "Score: 12 pts". The string and the
+ * glyph geometry are only rebuilt when the number changes.
+ */
+class HudValue {
+public:
+    HudValue(const char* prefix, const char* suffix);
+    // returns true if the text had to be rebuilt
+    bool setValue(int newValue);
+    sf::Text& getText() { return text; }
+    const sf::Text& getText() const { return text; }
+
+private:
+    const char* prefix;
+    const char* suffix;
+    int value;
+    bool valid;
+    // reused between rebuilds so formatting doesn't allocate
+    std::string buffer;
+    sf::Text text;
+};
+
+/**
+ * Every text drawn over the game, refreshed from the latest snapshot each frame
+ */
+class Hud {
+public:
+    Hud();
+    int init(const sf::Font& font, float sceneWidth, float sceneHeight);
+    void setRestartHint(const char* hint);
+    void update(const Snapshot& snapshot);
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    float sceneWidth;
+    float sceneHeight;
+    HudValue score;
+    HudValue countdown;
+    HudValue finalScore;
+    sf::Text speedBoostText;
+    sf::Text restartText;
+    bool speedBoosted;
+    bool gameEnded;
+};
@@ -0,0 +1,84 @@
+/*
+ * File: input_queue.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: InputQueue class header, timestamped direction key changes handed from the
+ * window thread to the simulation thread, and the input-to-display latency they give.
+ */
+
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Direction key changes on their way from the window thread to the simulation
+ * thread. The window thread stamps each change with the time it saw it, and
+ * the simulation applies every change stamped up to a tick's time at that
+ * tick: the tick gets what was held then, plus any direction pressed since
+ * the tick before, even if it was released already.
+ * Changes go through a fixed ring with one writer and one reader, so neither
+ * side locks or allocates. A change that finds the ring full is dropped, the
+ * next one still carries every key held.
+ * The window thread also hears which changes made it to the screen, which
+ * gives the input-to-display latency of each of them.
+ */
+class InputQueue {
+public:
+    struct Change {
+        sf::Time time;
+        std::uint32_t sequence;
+        // directions held after the change, and the one it pressed if any
+        std::uint8_t held;
+        std::uint8_t pressed;
+    };
+    struct LatencyReport {
+        std::size_t samples;
+        sf::Time median;
+        sf::Time p95;
+        sf::Time max;
+    };
+
+    static const std::size_t CAPACITY;
+    static const std::size_t LATENCY_SAMPLES;
+
+    InputQueue();
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+
+    // Window thread
+    void keyChanged(std::uint8_t direction, bool pressed, sf::Time time);
+    void releaseAll(sf::Time time);
+    // every change up to the sequence is now on screen
+    void presented(std::uint32_t sequence, sf::Time time);
+    LatencyReport getLatencyReport() const;
+    static LatencyReport summarize(const std::vector<sf::Time>& samples, std::size_t count);
+
+    // Simulation thread, the input of the tick due at the given time
+    std::uint8_t take(sf::Time tickTime);
+    // last change taken, for the snapshot showing its effect
+    std::uint32_t getTaken() const { return taken; }
+
+private:
+    std::vector<Change> changes;
+    std::atomic<std::size_t> head;
+    std::atomic<std::size_t> tail;
+
+    // window thread side
+    int keysDown[4];
+    std::uint8_t held;
+    std::uint32_t sequence;
+    std::uint32_t presentedSequence;
+    // time of each change by sequence, until it's presented
+    std::vector<sf::Time> changeTimes;
+    std::vector<sf::Time> latencies;
+    std::size_t latencyCount;
+
+    // simulation thread side
+    std::uint8_t tickHeld;
+    std::uint32_t taken;
+
+    void push(std::uint8_t newHeld, std::uint8_t pressed, sf::Time time);
+};
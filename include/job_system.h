@@ -0,0 +1,82 @@
+/*
+ * File: job_system.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: JobSystem class header, fixed pool of worker threads with work stealing.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Worker threads that each own a queue of jobs. A worker runs its own jobs
+ * newest first and, once out of work, steals the oldest jobs of the others.
+ * The thread calling parallelFor() helps out until its loop is done.
+ * Queues have a fixed size, so handing out work never allocates.
+ */
+class JobSystem {
+public:
+    explicit JobSystem(unsigned workerCount = defaultWorkerCount());
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(threads.size()); }
+    // one worker per core, leaving a core for the thread handing out the work
+    static unsigned defaultWorkerCount() {
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 0;
+    }
+
+    // Calls fn(begin, end) on chunks covering [0, count) across every thread,
+    // returning once all of them have run
+    template <typename Function>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Function&& fn) {
+        using Callable = typename std::remove_reference<Function>::type;
+        run(count, chunkSize, &fn, [](void* context, std::size_t begin, std::size_t end) {
+            (*static_cast<Callable*>(context))(begin, end);
+        });
+    }
+
+private:
+    using Task = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    struct Job {
+        Task task;
+        void* context;
+        std::size_t begin;
+        std::size_t end;
+        std::atomic<std::size_t>* remaining;
+    };
+    // Ring of jobs, owner pops the back and thieves pop the front
+    struct Queue {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        std::size_t head = 0;
+        std::size_t count = 0;
+    };
+
+    static const std::size_t QUEUE_CAPACITY;
+
+    // one queue per worker, plus the last one for the calling thread
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> queued;
+    bool stopping;
+
+    void run(std::size_t count, std::size_t chunkSize, void* context, Task task);
+    void workerLoop(std::size_t self);
+    bool push(std::size_t queue, const Job& job);
+    bool popBack(std::size_t queue, Job& job);
+    bool popFront(std::size_t queue, Job& job);
+    bool runOne(std::size_t self);
+};
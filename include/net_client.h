@@ -0,0 +1,102 @@
+/*
+ * File: net_client.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: NetClient class header, plays on a game server over UDP and
+ * predicts its own player in between.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "game_sim.h"
+#include "net_protocol.h"
+#include "snapshot.h"
+
+/**
+ * One player of a NetServer's game. Every tick it sends the directions held,
+ * numbered, and reads the states the server sent, acknowledging the newest so
+ * the next ones come coded against it. The server's state is always a round
+ * trip old, so the local player is predicted: it starts from where the
+ * newest state puts it and replays every input the server hadn't applied
+ * yet, with the same movement code the server runs. When the server
+ * disagrees (a boost, an input it got late) the next state pulls the player
+ * back in line.
+ */
+class NetClient {
+public:
+    // inputs and states kept, both by their number modulo HISTORY
+    static const std::size_t HISTORY;
+
+    NetClient();
+    ~NetClient();
+    // Ask the server for a player slot, the answer comes in through update()
+    int join(const sf::IpAddress& address, unsigned short port);
+    // Keep asking until the server answers, or the time runs out
+    int waitForWelcome(sf::Time timeout);
+    void leave();
+    bool isConnected() const { return connected; }
+    bool isRefused() const { return refused; }
+    // the server's world, as far as a client needs to know it
+    const SimConfig& getConfig() const { return config; }
+    std::size_t getPlayerIndex() const { return playerIndex; }
+
+    // One client tick: read what the server sent, send the input held, predict the player
+    void update(std::uint8_t input, sf::Time now);
+    void receive();
+
+    const NetState& getState() const { return states[latest]; }
+    bool hasState() const { return received; }
+    const sf::Vector2f& getPredictedPosition() const { return predicted; }
+    // when the input the newest state ends with was sent, zero before any
+    sf::Time getAckedInputTime() const;
+    // bytes of the states received so far, per state, the server sending one per tick
+    double getBytesPerTick() const;
+    std::uint64_t getStatesReceived() const { return statesReceived; }
+
+    // The newest state with the player where it's predicted, ready to draw
+    void capture(Snapshot& snapshot, sf::Time tickTime);
+
+private:
+    struct SentInput {
+        std::uint8_t input;
+        sf::Time time;
+    };
+
+    sf::UdpSocket socket;
+    sf::IpAddress serverAddress;
+    unsigned short serverPort;
+    bool connected;
+    bool refused;
+    SimConfig config;
+    sf::Vector2f worldSize;
+    std::size_t playerIndex;
+
+    std::uint32_t sequence;
+    std::vector<SentInput> inputs;
+    // decoded states at tick % HISTORY, the newest at latest
+    std::vector<NetState> states;
+    std::size_t latest;
+    bool received;
+    // what the last capture showed, for the positions the next one moves from
+    NetState shown;
+    bool shownValid;
+    sf::Vector2f predicted;
+    sf::Vector2f previousPredicted;
+
+    std::vector<std::uint8_t> buffer;
+    std::vector<std::uint8_t> message;
+    std::uint64_t stateBytes;
+    std::uint64_t statesReceived;
+
+    void handleWelcome(ByteReader& reader);
+    void handleState(ByteReader& reader, std::size_t size);
+    void sendInput(std::uint8_t input, sf::Time now);
+    void predict();
+    static void copyEntities(const std::vector<NetState::Entity>& current, const std::vector<NetState::Entity>* before,
+                             std::vector<Snapshot::Sprite>& sprites);
+};
@@ -0,0 +1,124 @@
+/*
+ * File: net_protocol.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Wire format between the game server and its clients, with the
+ * quantized world state and its delta coding.
+ */
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "game_sim.h"
+
+/**
+ * Datagrams between the server and its clients, each starting with its type
+ * byte. Numbers are varints, signed ones zigzag coded first.
+ *   JOIN     client: nothing else, sent until a WELCOME or FULL comes back
+ *   WELCOME  server: player index, player count, world scale, then both player
+ *            speeds and the game length in seconds as raw little endian floats
+ *   FULL     server: every player slot is taken
+ *   INPUT    client: round, last state tick received, input sequence, input
+ *   STATE    server: round, tick, baseline tick (0 for none), then the state
+ *            coded against that baseline, see NetState
+ *   LEAVE    client: nothing else
+ */
+class NetProtocol {
+public:
+    enum MessageType : std::uint8_t { JOIN, WELCOME, FULL, INPUT, STATE, LEAVE };
+
+    // Positions go on the wire in steps of 1 / POSITION_SCALE pixels
+    static const float POSITION_SCALE;
+    // Largest datagram either side sends or expects
+    static const std::size_t MAX_DATAGRAM;
+
+    static std::int32_t quantize(float value);
+    static float dequantize(std::int32_t value);
+};
+
+/**
+ * Appends varints and bytes to a buffer that keeps its memory between messages
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<std::uint8_t>& bytes) : bytes(bytes) { bytes.clear(); }
+    void putByte(std::uint8_t value) { bytes.push_back(value); }
+    void putVarint(std::uint64_t value);
+    void putSigned(std::int64_t value);
+    void putFloat(float value);
+
+private:
+    std::vector<std::uint8_t>& bytes;
+};
+
+/**
+ * Reads them back, once past the end every read gives 0 and ok() turns false
+ */
+class ByteReader {
+public:
+    ByteReader(const std::uint8_t* data, std::size_t size) : data(data), size(size), offset(0), failed(false) {}
+    std::uint8_t getByte();
+    std::uint64_t getVarint();
+    std::int64_t getSigned();
+    float getFloat();
+    bool ok() const { return !failed; }
+    bool atEnd() const { return offset == size; }
+
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+    std::size_t offset;
+    bool failed;
+};
+
+/**
+ * What a client gets to know of the world at one tick, with positions
+ * quantized. Entities are kept sorted by id so two states can be compared
+ * in one pass. A state is sent as the difference from an older state the
+ * client said it has (its baseline): players always go as differences,
+ * entities only when they moved, appeared, changed or went away. Without a
+ * baseline the same coding against an empty state sends everything.
+ */
+struct NetState {
+    struct Player {
+        std::int32_t x;
+        std::int32_t y;
+        std::int32_t score;
+        std::uint8_t boosted;
+        // the player's last input sequence the server had applied by this tick
+        std::uint32_t inputSequence;
+    };
+    struct Entity {
+        std::uint32_t id;
+        std::int32_t x;
+        std::int32_t y;
+        // Ghost::Color or Fruit::Kind
+        std::uint8_t look;
+    };
+
+    // bumped by the server on every new game, states of different rounds are never compared
+    std::uint8_t round = 0;
+    std::uint32_t tick = 0;
+    std::uint32_t timeLeftMs = 0;
+    bool gameEnded = false;
+    std::vector<Player> players;
+    std::vector<Entity> ghosts;
+    std::vector<Entity> fruits;
+
+    // room for a whole game of the config, so capturing and decoding never allocate
+    void reserve(const SimConfig& config);
+    // inputSequences holds one sequence per player
+    void capture(const GameSim& sim, std::uint8_t newRound, const std::uint32_t* inputSequences);
+
+    void encode(const NetState* baseline, ByteWriter& writer) const;
+    // returns false if the bytes don't hold a whole state
+    bool decode(const NetState* baseline, ByteReader& reader);
+
+private:
+    static void encodeEntities(const std::vector<Entity>& current, const std::vector<Entity>* baseline,
+                               ByteWriter& writer);
+    static bool decodeEntities(const std::vector<Entity>* baseline, ByteReader& reader,
+                               std::vector<Entity>& decoded);
+};
@@ -0,0 +1,88 @@
+/*
+ * File: net_server.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: NetServer class header, the authoritative game that clients
+ * play over UDP.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "game_sim.h"
+#include "net_protocol.h"
+#include "save_state.h"
+
+/**
+ * Runs the one true game, every player slot of its config open to a client.
+ * Clients send the directions they hold each tick and get the world back
+ * after every tick, coded against the last state they said they received,
+ * so a quiet world costs a few bytes per tick. States are kept for the last
+ * HISTORY ticks; a client that fell further behind than that gets a whole state.
+ * Everything happens on the caller's thread: receive() whenever, then tick()
+ * at the tick rate.
+ */
+class NetServer {
+public:
+    static const std::size_t HISTORY;
+    // a client not heard from for this many ticks has left
+    static const std::uint32_t CLIENT_TIMEOUT_TICKS;
+
+    NetServer(std::uint64_t seed, const SimConfig& config);
+    // 0 picks any free port
+    int start(unsigned short port);
+    unsigned short getPort() const { return socket.getLocalPort(); }
+
+    // Handle every message waiting, without blocking
+    void receive();
+    // One tick of the game with the inputs last heard, then a state to every client
+    void tick();
+    // A new game from the starting state, the clients staying in their slots
+    void restart(std::uint64_t newSeed);
+
+    const GameSim& getSim() const { return sim; }
+    std::uint8_t getRound() const { return round; }
+    std::size_t getClientCount() const;
+    // what the states sent so far cost on average, per client per tick
+    std::uint64_t getStateBytes() const { return stateBytes; }
+    std::uint64_t getStatesSent() const { return statesSent; }
+    double getBytesPerTick() const;
+
+private:
+    struct Client {
+        bool connected;
+        sf::IpAddress address;
+        unsigned short port;
+        std::uint8_t input;
+        // newest input sequence heard, older inputs arriving late are ignored
+        std::uint32_t sequence;
+        // newest tick of this round the client said it has, 0 for none
+        std::uint32_t ackTick;
+        std::uint32_t lastHeard;
+    };
+
+    GameSim sim;
+    SaveState startState;
+    std::uint8_t round;
+    sf::UdpSocket socket;
+    // one slot per player
+    std::vector<Client> clients;
+    std::vector<std::uint32_t> sequences;
+    // the state of each of the last HISTORY ticks, at tick % HISTORY
+    std::vector<NetState> history;
+    // ticks run since start, unlike the sim's tick count it goes on over restarts
+    std::uint32_t ticksRun;
+
+    std::vector<std::uint8_t> received;
+    std::vector<std::uint8_t> message;
+    std::uint64_t stateBytes;
+    std::uint64_t statesSent;
+
+    void handleJoin(const sf::IpAddress& address, unsigned short port);
+    void handleInput(Client& client, ByteReader& reader);
+    Client* findClient(const sf::IpAddress& address, unsigned short port);
+    void sendWelcome(std::size_t player);
+    void sendState(Client& client, const NetState& state);
+};
@@ -0,0 +1,125 @@
+/*
+ * File: pool.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Pool class, fixed number of reusable slots handed out from a free list.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "save_state.h"
+
+/**
+ * Slots for up to capacity() objects, all allocated by reserve(). acquire()
+ * and release() only move slot numbers on and off the free list, so once the
+ * pool is reserved they never touch the heap. A slot keeps its number for as
+ * long as it is in use, and released slots are handed out again newest first.
+ * Objects in released slots are left as they were, the next owner overwrites them.
+ */
+template <typename T>
+class Pool {
+public:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    explicit Pool(std::size_t capacity = 0) : live(0) { reserve(capacity); }
+
+    // Grow to the given number of slots, slots in use keep their number
+    void reserve(std::size_t capacity) {
+        if (capacity <= items.size()) {
+            return;
+        }
+        std::size_t old = items.size();
+        items.resize(capacity);
+        alive.resize(capacity, 0);
+        freeSlots.reserve(capacity);
+        // Lowest slots go on top of the stack, so a fresh pool fills from slot 0
+        std::vector<std::uint32_t> added;
+        for (std::size_t slot = capacity; slot-- > old;) {
+            added.push_back(static_cast<std::uint32_t>(slot));
+        }
+        freeSlots.insert(freeSlots.begin(), added.begin(), added.end());
+    }
+    // returns a free slot, or NONE if every slot is in use
+    std::uint32_t acquire() {
+        if (freeSlots.empty()) {
+            return NONE;
+        }
+        std::uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        alive[slot] = 1;
+        ++live;
+        return slot;
+    }
+    void release(std::uint32_t slot) {
+        alive[slot] = 0;
+        freeSlots.push_back(slot);
+        --live;
+    }
+    void clear() {
+        freeSlots.clear();
+        for (std::size_t slot = items.size(); slot-- > 0;) {
+            alive[slot] = 0;
+            freeSlots.push_back(static_cast<std::uint32_t>(slot));
+        }
+        live = 0;
+    }
+
+    // Every slot and the free stack as they are, so slots keep their numbers across a restore
+    void save(SaveState& state) const {
+        state.writeVector(items);
+        state.writeVector(alive);
+        state.writeVector(freeSlots);
+        state.write(live);
+    }
+    void restore(const SaveState& state, std::size_t& offset) {
+        state.readVector(offset, items);
+        state.readVector(offset, alive);
+        state.readVector(offset, freeSlots);
+        state.read(offset, live);
+    }
+
+    T& operator[](std::uint32_t slot) { return items[slot]; }
+    const T& operator[](std::uint32_t slot) const { return items[slot]; }
+    bool isAlive(std::uint32_t slot) const { return alive[slot] != 0; }
+    std::size_t size() const { return live; }
+    bool empty() const { return live == 0; }
+    std::size_t capacity() const { return items.size(); }
+
+    // Walks the slots in use, in slot order
+    class ConstIterator {
+    public:
+        ConstIterator(const Pool& pool, std::uint32_t slot) : pool(pool), slot(slot) { skipFree(); }
+        const T& operator*() const { return pool.items[slot]; }
+        std::uint32_t getSlot() const { return slot; }
+        ConstIterator& operator++() {
+            ++slot;
+            skipFree();
+            return *this;
+        }
+        bool operator!=(const ConstIterator& other) const { return slot != other.slot; }
+
+    private:
+        const Pool& pool;
+        std::uint32_t slot;
+
+        void skipFree() {
+            while (slot < pool.items.size() && !pool.alive[slot]) {
+                ++slot;
+            }
+        }
+    };
+    ConstIterator begin() const { return ConstIterator(*this, 0); }
+    ConstIterator end() const { return ConstIterator(*this, static_cast<std::uint32_t>(items.size())); }
+
+private:
+    std::vector<T> items;
+    std::vector<std::uint8_t> alive;
+    // stack of free slots, the next one handed out is at the back
+    std::vector<std::uint32_t> freeSlots;
+    std::size_t live;
+};
+
+template <typename T>
+constexpr std::uint32_t Pool<T>::NONE;
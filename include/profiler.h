@@ -0,0 +1,124 @@
+/*
+ * File: profiler.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Profiler class header, scoped timing zones kept in a fixed ring
+ * buffer, tallied per frame and dumped as Chrome trace JSON.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "alloc_tracker.h"
+
+/**
+ * Collects timing zones from any thread. Zones go into a ring buffer that is
+ * sized once, so recording never allocates and old zones are overwritten.
+ * Reading (frame tallies, trace dumps) is meant for the window thread between
+ * frames. The simulation thread keeps recording meanwhile, so its newest zone
+ * may be tallied while still being written, which can only throw off that
+ * zone's numbers for the frame.
+ */
+class Profiler {
+public:
+    struct Event {
+        const char* name; // must be a string literal, only the pointer is kept
+        std::int64_t start; // nanoseconds since the profiler was created
+        std::int64_t end;
+        std::uint32_t thread;
+        // heap allocations made by the zone's thread inside it, 0 without allocation tracking
+        std::uint32_t allocations;
+        std::uint32_t bytes;
+    };
+    // Time spent in one zone during a frame, over every thread
+    struct ZoneStats {
+        const char* name;
+        std::int64_t total;
+        std::uint32_t calls;
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+    };
+
+    static const std::size_t EVENT_CAPACITY;
+    static const std::size_t MAX_ZONES;
+    static const std::size_t FRAME_HISTORY;
+
+    Profiler();
+    // the profiler used by the PROFILE_* macros
+    static Profiler& get();
+
+    std::int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+    }
+    void record(const char* name, std::int64_t start, std::int64_t end, std::uint64_t allocations = 0,
+                std::uint64_t bytes = 0);
+    // closes the current frame and tallies its zones
+    void endFrame();
+    void clear();
+
+    std::uint64_t getEventCount() const { return written.load(std::memory_order_relaxed); }
+    const std::vector<ZoneStats>& getFrameZones() const { return frameZones; }
+    // frame times in nanoseconds, oldest first
+    std::size_t getFrameCount() const { return frameCount < FRAME_HISTORY ? frameCount : FRAME_HISTORY; }
+    std::int64_t getFrameTime(std::size_t index) const;
+    // allocations of the last frame, over every thread
+    const AllocTracker::Counts& getFrameAllocations() const { return frameAllocations; }
+
+    int dumpChromeTrace(const std::string& path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point origin;
+    std::vector<Event> events;
+    std::atomic<std::uint64_t> written;
+    // events before this index belong to frames already tallied
+    std::uint64_t frameStartEvent;
+    std::int64_t frameStartTime;
+
+    std::vector<ZoneStats> frameZones;
+    std::vector<std::int64_t> frameTimes;
+    std::size_t frameCount;
+    AllocTracker::Counts frameStartAllocations;
+    AllocTracker::Counts frameAllocations;
+
+    static std::uint32_t threadIndex();
+};
+
+/**
+ * Times the scope it lives in
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+            : name(name), startAllocations(AllocTracker::getThread()), start(Profiler::get().now()) {}
+    ~ProfileScope() {
+        std::int64_t end = Profiler::get().now();
+        AllocTracker::Counts allocations = AllocTracker::getThread();
+        Profiler::get().record(name, start, end, allocations.allocations - startAllocations.allocations,
+                               allocations.bytes - startAllocations.bytes);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    AllocTracker::Counts startAllocations;
+    std::int64_t start;
+};
+
+// Zones are only recorded in builds with GAME_PROFILING defined, otherwise the
+// macros expand to nothing
+#ifdef GAME_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::get().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
@@ -0,0 +1,46 @@
+/*
+ * File: profiler_overlay.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ProfilerOverlay class header, frame time graph and per zone times drawn over the game.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "profiler.h"
+
+/**
+ * Graph of the last frame times and a line per zone of the last frame. The
+ * graph follows every frame, the numbers only a few times a second so they
+ * can be read.
+ */
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+    int init(const sf::Font& font, const sf::Vector2f& position);
+    void update(const Profiler& profiler);
+    void draw(sf::RenderTarget& target) const;
+
+private:
+    static const float GRAPH_WIDTH;
+    static const float GRAPH_HEIGHT;
+    // frame time at the top of the graph, in milliseconds
+    static const float GRAPH_MAX_MS;
+    static const float TARGET_MS;
+    static const unsigned REFRESH_FRAMES;
+    static const unsigned CHARACTER_SIZE;
+
+    sf::Vector2f position;
+    sf::RectangleShape panel;
+    sf::VertexArray graph;
+    sf::VertexArray targetLine;
+    // first line is the frame time, then one per zone
+    std::vector<sf::Text> lines;
+    std::size_t lineCount;
+    unsigned framesSinceRefresh;
+    std::string buffer;
+
+    void refreshLines(const Profiler& profiler);
+};
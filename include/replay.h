@@ -0,0 +1,75 @@
+/*
+ * File: replay.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ReplayWriter and ReplayReader classes header, record the seed and
+ * every tick's input of a session so it can be simulated again exactly.
+ */
+
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * Replay file layout, all numbers little endian:
+ *   "PMRP", version byte, seed (8 bytes), world scale byte
+ *   runs until the end of the file, each one a varint of (ticks << 4 | input)
+ * A run is an input held for that many ticks in a row, so a held key costs a
+ * couple of bytes however long it is held.
+ */
+class Replay {
+public:
+    static const char MAGIC[4];
+    static const std::uint8_t VERSION;
+    // bits of the run's varint taken by the input
+    static const unsigned INPUT_BITS;
+};
+
+/**
+ * Streams a session to a file while it's being played
+ */
+class ReplayWriter {
+public:
+    ReplayWriter() = default;
+    ~ReplayWriter();
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    int open(const std::string& path, std::uint64_t seed, int worldScale = 1);
+    // input held during the next tick
+    void record(std::uint8_t input);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+    std::uint64_t getTicks() const { return ticks; }
+
+private:
+    std::ofstream file;
+    std::uint8_t runInput = 0;
+    std::uint64_t runLength = 0;
+    std::uint64_t ticks = 0;
+
+    void writeRun();
+};
+
+/**
+ * Reads a replay back one tick at a time, never holding more than the
+ * stream's buffer in memory
+ */
+class ReplayReader {
+public:
+    int open(const std::string& path);
+    std::uint64_t getSeed() const { return seed; }
+    int getWorldScale() const { return worldScale; }
+    // input of the next tick, false once the session is over
+    bool next(std::uint8_t& input);
+
+private:
+    std::ifstream file;
+    std::uint64_t seed = 0;
+    int worldScale = 1;
+    std::uint8_t runInput = 0;
+    std::uint64_t runLeft = 0;
+
+    bool readRun();
+};
@@ -0,0 +1,74 @@
+/*
+ * File: resource_manager.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ResourceManager class header, every texture and font the game uses.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "asset_bundle.h"
+#include "texture_atlas.h"
+
+/**
+ * Loads every asset once at startup, after that they're looked up by handle.
+ * Ghost and fruit images go into one atlas and are drawn by region.
+ * Assets come from the bundle the asset baker writes when there is one,
+ * already sized and decoded, and from the original files otherwise.
+ */
+class ResourceManager {
+public:
+    // What the asset baker puts in the bundle for one file
+    struct BakeItem {
+        const char* path;
+        bool image;
+        // pixels wide and high it's drawn at, 0 to keep the image's own size
+        unsigned drawnSize;
+    };
+    static const char* const BUNDLE_FILE;
+
+    // Textures drawn on their own
+    enum TextureId { BACKGROUND, PLAYER, TEXTURE_COUNT };
+    // Regions of the entity atlas, in Ghost::Color then Fruit::Kind order
+    enum SpriteId {
+        GHOST_BLUE, GHOST_ORANGE, GHOST_PINK, GHOST_RED,
+        FRUIT_CHERRY, FRUIT_MELON, FRUIT_BERRY, SPRITE_COUNT
+    };
+    enum FontId { MAIN_FONT, FONT_COUNT };
+
+    // returns true if every asset loaded, the ones that didn't are in getErrors()
+    bool loadAll();
+    const std::vector<std::string>& getErrors() const { return errors; }
+    static std::vector<BakeItem> getBakeList();
+    // how long loadAll() took, and how many assets it found in the bundle
+    sf::Time getLoadTime() const { return loadTime; }
+    int getBundledCount() const { return bundledCount; }
+    static int getAssetCount() { return TEXTURE_COUNT + SPRITE_COUNT + FONT_COUNT; }
+
+    const sf::Texture& getTexture(TextureId id) const { return textures[id]; }
+    const sf::Texture& getAtlas() const { return atlas.getTexture(); }
+    const sf::IntRect& getSprite(SpriteId id) const { return atlas.getRegion(spriteRegions[id]); }
+    const sf::Font& getFont(FontId id) const { return fonts[id]; }
+
+private:
+    static const char* const TEXTURE_FILES[TEXTURE_COUNT];
+    static const char* const SPRITE_FILES[SPRITE_COUNT];
+    static const char* const FONT_FILES[FONT_COUNT];
+    static const unsigned TEXTURE_SIZES[TEXTURE_COUNT];
+    static const unsigned SPRITE_SIZES[SPRITE_COUNT];
+
+    // Declared first so it's unmapped last, fonts read from it for as long as they live
+    AssetBundle bundle;
+    sf::Time loadTime;
+    int bundledCount = 0;
+    sf::Texture textures[TEXTURE_COUNT];
+    TextureAtlas atlas;
+    int spriteRegions[SPRITE_COUNT] = {};
+    sf::Font fonts[FONT_COUNT];
+    std::vector<std::string> errors;
+
+    const AssetBundle::Entry* findImage(const char* path) const;
+    const AssetBundle::Entry* findFile(const char* path) const;
+};
@@ -0,0 +1,37 @@
+/*
+ * File: rewind_buffer.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: RewindBuffer class header, ring of the last save states of a game.
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "game_sim.h"
+#include "save_state.h"
+
+/**
+ * The last few seconds of a game, one save state per tick. Pushing past the
+ * capacity overwrites the oldest state, popping restores the newest one, so
+ * popping once per tick plays the game back in reverse.
+ */
+class RewindBuffer {
+public:
+    explicit RewindBuffer(std::size_t capacity);
+    // Size every state for the sim's biggest save, so pushing never allocates
+    void reserve(const GameSim& sim);
+
+    void push(const GameSim& sim);
+    // returns 0 if a state was restored, 1 if there was none left
+    int pop(GameSim& sim);
+    void clear() { count = 0; }
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return states.size(); }
+
+private:
+    std::vector<SaveState> states;
+    // slot of the newest state
+    std::size_t newest;
+    std::size_t count;
+};
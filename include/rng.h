@@ -0,0 +1,65 @@
+/*
+ * File: rng.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Rng class, small seedable PCG32 generator shared by the simulation.
+ */
+
+#pragma once
+#include <cstdint>
+#include <random>
+
+/**
+ * PCG32 (XSH RR variant). 16 bytes of state and a handful of instructions per
+ * number, with independent streams so every entity can carry its own substream.
+ */
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed = 0, std::uint64_t stream = 0) : state(0), inc((stream << 1u) | 1u) {
+        next();
+        state += seed;
+        next();
+    }
+
+    std::uint32_t next() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        auto xorShifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        auto rot = static_cast<std::uint32_t>(old >> 59u);
+        return (xorShifted >> rot) | (xorShifted << ((32u - rot) & 31u));
+    }
+    // returns a float in [min, max)
+    float uniform(float min, float max) {
+        return min + (max - min) * (static_cast<float>(next() >> 8u) * (1.0f / 16777216.0f));
+    }
+    // returns an int in [min, max]
+    int uniformInt(int min, int max) {
+        auto range = static_cast<std::uint64_t>(max - min) + 1u;
+        return min + static_cast<int>((static_cast<std::uint64_t>(next()) * range) >> 32u);
+    }
+    // returns two numbers as one, high half first. The draws are separate statements
+    // since the order of two calls within one expression is up to the compiler.
+    std::uint64_t next64() {
+        std::uint64_t high = next();
+        std::uint64_t low = next();
+        return (high << 32u) | low;
+    }
+    // returns a new generator on its own stream, seeded from this one
+    Rng split() {
+        std::uint64_t seed = next64();
+        std::uint64_t stream = next64();
+        return Rng(seed, stream);
+    }
+
+    // Seed for runs that don't ask for a specific one
+    static std::uint64_t randomSeed() {
+        std::random_device rd;
+        std::uint64_t high = rd();
+        std::uint64_t low = rd();
+        return (high << 32u) | low;
+    }
+
+private:
+    std::uint64_t state;
+    std::uint64_t inc;
+};
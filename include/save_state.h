@@ -0,0 +1,89 @@
+/*
+ * File: save_state.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: SaveState class, flat byte image of a whole simulation for
+ * instant restarts and rewinding.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * The full state of a simulation as one block of bytes. Everything the
+ * simulation keeps is plain values and indices, never pointers, so saving
+ * is a memcpy of each field and array in turn and restoring is the same
+ * memcpy back. The bytes are only meaningful to the build and config that
+ * wrote them, they're for in-process restarts and rewinding, not for files.
+ * Once reserved (or after the first save of the biggest state), saving and
+ * restoring never allocate.
+ */
+class SaveState {
+public:
+    void reserve(std::size_t capacity) {
+        if (capacity > bytes.size()) {
+            bytes.resize(capacity);
+        }
+    }
+    void clear() { used = 0; }
+    bool empty() const { return used == 0; }
+    std::size_t size() const { return used; }
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "saved values must be copyable as bytes");
+        writeBytes(&value, sizeof(T));
+    }
+    // the element count, then the elements
+    template <typename T>
+    void writeVector(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "saved values must be copyable as bytes");
+        write(static_cast<std::uint64_t>(values.size()));
+        writeBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    // Reading starts at offset 0 and moves offset past what was read
+    template <typename T>
+    void read(std::size_t& offset, T& value) const {
+        readBytes(offset, &value, sizeof(T));
+    }
+    // resizing within the vector's capacity, which it keeps from the simulation's reserve
+    template <typename T>
+    void readVector(std::size_t& offset, std::vector<T>& values) const {
+        static_assert(std::is_trivially_copyable<T>::value, "saved values must be copyable as bytes");
+        std::uint64_t count = 0;
+        read(offset, count);
+        values.resize(static_cast<std::size_t>(count));
+        readBytes(offset, values.data(), values.size() * sizeof(T));
+    }
+
+private:
+    std::vector<unsigned char> bytes;
+    std::size_t used = 0;
+
+    void writeBytes(const void* source, std::size_t count) {
+        if (used + count > bytes.size()) {
+            bytes.resize(std::max(used + count, bytes.size() * 2));
+        }
+        if (count != 0) {
+            std::memcpy(bytes.data() + used, source, count);
+        }
+        used += count;
+    }
+    // past the end, offset lands after the state so the reader can tell it came up short
+    void readBytes(std::size_t& offset, void* destination, std::size_t count) const {
+        if (offset + count > used) {
+            offset = used + 1;
+            return;
+        }
+        if (count != 0) {
+            std::memcpy(destination, bytes.data() + offset, count);
+        }
+        offset += count;
+    }
+};
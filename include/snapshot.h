@@ -0,0 +1,50 @@
+/*
+ * File: snapshot.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Snapshot struct header, everything drawn for one tick of the simulation.
+ */
+
+#pragma once
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "game_sim.h"
+
+/**
+ * What the renderer needs of one tick: positions at this tick and the one
+ * before for interpolation, each entity's look, and the HUD values. It's a
+ * copy, so the renderer can draw it while the simulation moves on.
+ */
+struct Snapshot {
+    struct Sprite {
+        sf::Vector2f previous;
+        sf::Vector2f position;
+        // Ghost::Color or Fruit::Kind, depending on the list it's in
+        std::uint8_t look;
+    };
+
+    std::uint32_t tick = 0;
+    // when the tick was due on the game's clock
+    sf::Time time;
+    // last input change the tick took, see InputQueue
+    std::uint32_t inputSequence = 0;
+    sf::Vector2f previousPlayerPosition;
+    sf::Vector2f playerPosition;
+    // every other player, look being their player index
+    std::vector<Sprite> rivals;
+    std::vector<Sprite> ghosts;
+    std::vector<Sprite> fruits;
+
+    int score = 0;
+    sf::Time timeLeft;
+    bool speedBoosted = false;
+    bool gameEnded = false;
+    // in a networked game, when the input the shown server state ends with was sent
+    sf::Time ackedInputTime;
+
+    // room for every entity of a game, so capture() never allocates
+    void reserve(const SimConfig& config);
+    void capture(const GameSim& sim, sf::Time tickTime);
+};
@@ -0,0 +1,60 @@
+/*
+ * File: spatial_grid.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: SpatialGrid class header, uniform grid over the scene for
+ * radius queries on entities.
+ */
+
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Buckets entities by the cell they stand in. Each cell keeps its members'
+ * coordinates packed, so a radius query runs the collision kernel over the
+ * few cells it overlaps instead of over every entity.
+ * Entities are known by an id chosen by the owner (their index in its store).
+ */
+class SpatialGrid {
+public:
+    SpatialGrid(float width, float height, float cellSize);
+    // Room for ids below the given count, so inserting and moving them never allocates
+    void reserve(std::size_t entities);
+
+    void insert(std::uint32_t id, const sf::Vector2f& position);
+    void move(std::uint32_t id, const sf::Vector2f& position);
+    void remove(std::uint32_t id);
+    // The entity known as `from` is now known as `to`, after a swap-and-pop in the owner
+    void rename(std::uint32_t from, std::uint32_t to);
+    void clear();
+
+    // Replaces the contents of found with the id of every entity closer than radius to center
+    void query(const sf::Vector2f& center, float radius, std::vector<std::uint32_t>& found) const;
+    bool anyWithin(const sf::Vector2f& center, float radius) const;
+
+private:
+    struct Cell {
+        std::vector<std::uint32_t> ids;
+        std::vector<float> xs;
+        std::vector<float> ys;
+    };
+
+    // past this, cells grow when entities crowd into them instead of all reserving up front
+    static const std::size_t MAX_CELL_RESERVE;
+
+    float cellSize;
+    int columns;
+    int rows;
+    std::vector<Cell> cells;
+    // where each id currently is, indexed by id
+    std::vector<std::uint32_t> cellOf;
+    std::vector<std::uint32_t> slotOf;
+
+    int column(float x) const;
+    int row(float y) const;
+    std::uint32_t cellIndex(const sf::Vector2f& position) const;
+    void removeFromCell(std::uint32_t id);
+};
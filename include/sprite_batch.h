@@ -0,0 +1,25 @@
+/*
+ * File: sprite_batch.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: SpriteBatch class header, collects textured squares for one draw call.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+/**
+ * Every sprite added between begin() and draw() ends up in a single vertex
+ * array, drawn with one atlas texture. The array keeps its memory between frames.
+ */
+class SpriteBatch {
+public:
+    SpriteBatch();
+    void begin();
+    // Square of the given half size centered on position, showing region of the texture
+    void add(const sf::Vector2f& position, float halfSize, const sf::IntRect& region);
+    void draw(sf::RenderTarget& target, const sf::Texture& texture) const;
+
+private:
+    sf::VertexArray vertices;
+};
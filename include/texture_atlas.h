@@ -0,0 +1,33 @@
+/*
+ * File: texture_atlas.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: TextureAtlas class header, packs several images into one texture.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/**
+ * Images are added first, then build() packs them in rows into a single
+ * texture so everything drawn from it can go in one draw call.
+ */
+class TextureAtlas {
+public:
+    // returns the region id of the image in the atlas
+    int add(const sf::Image& image);
+    // returns true if every image fit and the texture was created
+    bool build();
+
+    const sf::Texture& getTexture() const { return texture; }
+    const sf::IntRect& getRegion(int id) const { return regions[id]; }
+
+private:
+    // empty pixels around each image so smoothing doesn't bleed the neighbours in
+    static const unsigned PADDING;
+
+    std::vector<sf::Image> images;
+    std::vector<sf::IntRect> regions;
+    sf::Texture texture;
+};
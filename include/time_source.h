@@ -0,0 +1,41 @@
+/*
+ * File: time_source.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Time sources feeding the fixed timestep loop, either the real
+ * clock or a virtual one that is moved forward by hand.
+ */
+
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+class TimeSource {
+public:
+    virtual ~TimeSource() = default;
+    // returns the time passed since the source was created
+    virtual sf::Time now() const = 0;
+};
+
+/**
+ * Wall clock time
+ */
+class RealTimeSource : public TimeSource {
+public:
+    sf::Time now() const override { return clock.getElapsedTime(); }
+
+private:
+    sf::Clock clock;
+};
+
+/**
+ * Time that only moves when told to, for tests and offline runs
+ */
+class VirtualTimeSource : public TimeSource {
+public:
+    sf::Time now() const override { return current; }
+    void advance(sf::Time delta) { current += delta; }
+
+private:
+    sf::Time current;
+};
@@ -0,0 +1,98 @@
+/*
+ * File: timer_wheel.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: TimerWheel class header, schedules game events by tick.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pool.h"
+#include "save_state.h"
+
+/**
+ * Hashed timer wheel: a timer due at tick t waits in slot t % slot count, so
+ * advancing a tick only looks at the timers of one slot. Timers further away
+ * than a full turn of the wheel share a slot with nearer ones and are skipped
+ * until their turn comes round.
+ * Timers live in a pool and each slot is a linked list through it, so once
+ * the pool is big enough scheduling and firing never allocate. A full pool
+ * doubles rather than drop a timer.
+ * advance() has to be called for every tick in order, a skipped tick's timers
+ * would wait a whole turn.
+ */
+class TimerWheel {
+public:
+    struct Timer {
+        std::uint32_t tick;
+        // what to do and to whom, up to the owner
+        std::uint8_t type;
+        std::uint32_t target;
+        // lets the owner tell a timer of a removed target from one of its replacement
+        std::uint32_t generation;
+    };
+
+    explicit TimerWheel(std::size_t slotCount = DEFAULT_SLOTS, std::size_t capacity = 0);
+    void reserve(std::size_t capacity) { nodes.reserve(capacity); }
+
+    // timers at or before the last advanced tick fire on the next one
+    void schedule(const Timer& timer);
+    void clear();
+    // pending timers fire in the same order after a restore
+    void save(SaveState& state) const;
+    void restore(const SaveState& state, std::size_t& offset);
+    std::size_t size() const { return count; }
+    std::uint32_t getTick() const { return currentTick; }
+
+    // Moves to the given tick and calls fire(timer) for every timer due on it,
+    // in the order they were scheduled. fire may schedule new timers or clear().
+    template <typename Function>
+    void advance(std::uint32_t tick, Function&& fire) {
+        currentTick = tick;
+        std::uint32_t clearsBefore = clears;
+        // Take the whole list out, timers not due yet go back as they come
+        std::size_t slot = tick & mask;
+        std::uint32_t node = slots[slot].head;
+        slots[slot] = List();
+        while (node != Pool<Node>::NONE) {
+            std::uint32_t next = nodes[node].next;
+            if (nodes[node].timer.tick == tick) {
+                Timer timer = nodes[node].timer;
+                nodes.release(node);
+                --count;
+                fire(timer);
+                // The rest of the list went with the clear
+                if (clears != clearsBefore) {
+                    return;
+                }
+            } else {
+                append(slot, node);
+            }
+            node = next;
+        }
+    }
+
+private:
+    static const std::size_t DEFAULT_SLOTS;
+
+    struct Node {
+        Timer timer;
+        std::uint32_t next;
+    };
+    // first and last node of a slot, so timers fire in the order they came
+    struct List {
+        std::uint32_t head = Pool<Node>::NONE;
+        std::uint32_t tail = Pool<Node>::NONE;
+    };
+
+    Pool<Node> nodes;
+    std::vector<List> slots;
+    std::size_t mask;
+    std::size_t count;
+    std::uint32_t currentTick;
+    std::uint32_t clears;
+
+    void append(std::size_t slot, std::uint32_t node);
+};
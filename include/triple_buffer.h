@@ -0,0 +1,68 @@
+/*
+ * File: triple_buffer.h
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: TripleBuffer class, lock-free hand-off of the latest value from one thread to another.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Three copies of a value shared by one writer thread and one reader thread.
+ * The writer fills its back copy and publishes it, the reader takes the last
+ * published copy as its front. Neither side ever waits for the other: a
+ * publish replaces a copy the reader hasn't taken yet, and the reader keeps
+ * its front until something newer is published.
+ * Copies are only ever swapped, never copied, so a value that owns memory is
+ * reused as is and the buffer doesn't allocate after construction.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), middle(1), front(2) {}
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Every copy, to size them before the threads start
+    T& getCopy(int index) { return copies[index]; }
+
+    /**
+     * Writer side, the copy being filled. It still holds whatever was
+     * published into it before, so it has to be overwritten whole.
+     */
+    T& getBack() { return copies[back]; }
+    /**
+     * Writer side, hand the back copy to the reader and take a free one
+     */
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX;
+    }
+
+    /**
+     * Reader side, take the last published copy if there is a new one
+     * @return true if the front copy changed
+     */
+    bool update() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        std::uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX;
+        return true;
+    }
+    // Reader side, the copy taken by the last update()
+    const T& getFront() const { return copies[front]; }
+
+private:
+    // the middle index carries whether it was published since the reader last took it
+    static const std::uint8_t INDEX = 3;
+    static const std::uint8_t FRESH = 4;
+
+    T copies[3];
+    std::uint8_t back;
+    std::atomic<std::uint8_t> middle;
+    std::uint8_t front;
+};
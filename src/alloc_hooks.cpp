@@ -0,0 +1,64 @@
+/*
+ * File: alloc_hooks.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Replacement global operator new/delete feeding AllocTracker.
+ * Linking this file into a target is what turns allocation tracking on.
+ */
+
+#include "alloc_tracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+const bool hooksInstalled = AllocTracker::enable();
+
+void* allocate(std::size_t size) {
+    AllocTracker::recordAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+void release(void* pointer) {
+    if (pointer != nullptr) {
+        AllocTracker::recordFree();
+        std::free(pointer);
+    }
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    release(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    release(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    release(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    release(pointer);
+}
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    release(pointer);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    release(pointer);
+}
@@ -0,0 +1,54 @@
+/*
+ * File: alloc_tracker.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: AllocTracker class, counts heap allocations made through operator new.
+ */
+
+#include "alloc_tracker.h"
+#include <atomic>
+
+// Plain zero-initialized statics, so allocations made before main are counted too
+namespace {
+std::atomic<std::uint64_t> totalAllocations(0);
+std::atomic<std::uint64_t> totalBytes(0);
+std::atomic<std::uint64_t> totalFrees(0);
+thread_local std::uint64_t threadAllocations = 0;
+thread_local std::uint64_t threadBytes = 0;
+thread_local std::uint64_t threadFrees = 0;
+} // namespace
+
+bool AllocTracker::enabled = false;
+
+/**
+ * Mark the counters as live, done once by the hooks when they're linked in
+ * @return true, so the hooks can use it as a static initializer
+ */
+bool AllocTracker::enable() {
+    enabled = true;
+    return true;
+}
+/**
+ * Allocations so far by every thread
+ */
+AllocTracker::Counts AllocTracker::getTotal() {
+    return Counts{totalAllocations.load(std::memory_order_relaxed), totalBytes.load(std::memory_order_relaxed),
+                  totalFrees.load(std::memory_order_relaxed)};
+}
+/**
+ * Allocations so far by the calling thread
+ */
+AllocTracker::Counts AllocTracker::getThread() {
+    return Counts{threadAllocations, threadBytes, threadFrees};
+}
+
+void AllocTracker::recordAllocation(std::size_t bytes) {
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+    ++threadAllocations;
+    threadBytes += bytes;
+}
+void AllocTracker::recordFree() {
+    totalFrees.fetch_add(1, std::memory_order_relaxed);
+    ++threadFrees;
+}
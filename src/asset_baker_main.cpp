@@ -0,0 +1,85 @@
+/*
+ * File: asset_baker_main.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Asset baker, decodes the game's images once, shrinks them to the
+ * size they're drawn at and packs them with the font into one asset bundle.
+ */
+
+#include "asset_bundle.h"
+#include "resource_manager.h"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * Run from the directory holding resources/, by default the bundle goes where the game looks for it
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        std::cerr << "Usage: asset_baker [OUTPUT]   (default " << ResourceManager::BUNDLE_FILE << ")" << std::endl;
+        return 1;
+    }
+    std::string output = argc == 2 ? argv[1] : ResourceManager::BUNDLE_FILE;
+
+    AssetBundleWriter writer;
+    std::vector<std::uint8_t> resized;
+    std::size_t sourceBytes = 0;
+    sf::Time decodeTime;
+    for (const ResourceManager::BakeItem& item : ResourceManager::getBakeList()) {
+        std::ifstream file(item.path, std::ios::binary);
+        std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!file || bytes.empty()) {
+            std::cerr << "Could not read " << item.path << std::endl;
+            return 1;
+        }
+        sourceBytes += bytes.size();
+        if (!item.image) {
+            writer.addFile(item.path, bytes);
+            std::printf("%-32s %8zu bytes, as is\n", item.path, bytes.size());
+            continue;
+        }
+
+        // What the game pays for every image at startup without a bundle
+        sf::Clock clock;
+        sf::Image image;
+        if (!image.loadFromMemory(bytes.data(), bytes.size())) {
+            std::cerr << "Could not decode " << item.path << std::endl;
+            return 1;
+        }
+        decodeTime += clock.getElapsedTime();
+
+        sf::Vector2u size = image.getSize();
+        const std::uint8_t* pixels = image.getPixelsPtr();
+        unsigned width = size.x;
+        unsigned height = size.y;
+        // Only ever shrunk, keeping the aspect ratio with the longer side at the drawn size
+        if (item.drawnSize != 0 && std::max(size.x, size.y) > item.drawnSize) {
+            width = std::max(1u, static_cast<unsigned>(static_cast<std::uint64_t>(size.x) * item.drawnSize /
+                                                       std::max(size.x, size.y)));
+            height = std::max(1u, static_cast<unsigned>(static_cast<std::uint64_t>(size.y) * item.drawnSize /
+                                                        std::max(size.x, size.y)));
+            AssetBundle::downsample(pixels, size.x, size.y, width, height, resized);
+            pixels = resized.data();
+        }
+        writer.addImage(item.path, width, height, pixels);
+        std::printf("%-32s %4ux%-4u -> %4ux%-4u %8zu bytes\n", item.path, size.x, size.y, width, height,
+                    static_cast<std::size_t>(width) * height * 4);
+    }
+
+    if (writer.write(output) != 0) {
+        std::cerr << "Could not write " << output << std::endl;
+        return 1;
+    }
+    std::ifstream written(output, std::ios::binary | std::ios::ate);
+    std::printf("%s: %lld bytes from %zu bytes of sources, %.1f ms of image decoding saved per startup\n",
+                output.c_str(), static_cast<long long>(written.tellg()), sourceBytes,
+                decodeTime.asMicroseconds() / 1000.0);
+    return 0;
+}
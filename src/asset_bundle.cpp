@@ -0,0 +1,265 @@
+/*
+ * File: asset_bundle.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: AssetBundle and AssetBundleWriter classes, memory mapping of
+ * the baked asset bundle and the writing and resizing done by the baker
+ */
+
+#include "asset_bundle.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char AssetBundle::MAGIC[4] = {'P', 'M', 'A', 'B'};
+const std::uint32_t AssetBundle::VERSION = 1;
+const std::size_t AssetBundle::NAME_SIZE;
+
+namespace {
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+};
+// Asset data starts on this boundary, so pixel rows can be read a whole vector at a time
+const std::size_t ALIGNMENT = 16;
+
+std::size_t alignUp(std::size_t offset) {
+    return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+} // namespace
+
+#ifdef _WIN32
+AssetBundle::AssetBundle() : data(nullptr), size(0), entries(nullptr), entryCount(0), file(nullptr), mapping(nullptr) {
+}
+#else
+AssetBundle::AssetBundle() : data(nullptr), size(0), entries(nullptr), entryCount(0) {
+}
+#endif
+
+AssetBundle::~AssetBundle() {
+    close();
+}
+
+/**
+ * Map the bundle into memory and check its table of contents
+ * @return 0 if it's a bundle this build can read, 1 otherwise
+ */
+int AssetBundle::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return 1;
+    }
+    file = handle;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return 1;
+    }
+    mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return 1;
+    }
+    data = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return 1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return 1;
+    }
+    void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file open on its own
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return 1;
+    }
+    data = static_cast<const std::uint8_t*>(mapped);
+    size = static_cast<std::size_t>(info.st_size);
+#endif
+    if (data == nullptr || !validate()) {
+        close();
+        return 1;
+    }
+    return 0;
+}
+/**
+ * Every entry has to lie within the file, images holding exactly their pixels
+ */
+bool AssetBundle::validate() {
+    Header header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.entryCount > (size - sizeof(header)) / sizeof(Entry)) {
+        return false;
+    }
+    entries = reinterpret_cast<const Entry*>(data + sizeof(header));
+    entryCount = header.entryCount;
+    for (std::size_t i = 0; i < entryCount; ++i) {
+        const Entry& entry = entries[i];
+        if (entry.offset > size || entry.size > size - entry.offset ||
+            std::memchr(entry.name, '\0', NAME_SIZE) == nullptr) {
+            return false;
+        }
+        if (entry.width != 0 && entry.size != static_cast<std::uint64_t>(entry.width) * entry.height * 4) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AssetBundle::close() {
+#ifdef _WIN32
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+    if (file != nullptr) {
+        CloseHandle(file);
+    }
+    file = nullptr;
+    mapping = nullptr;
+#else
+    if (data != nullptr) {
+        munmap(const_cast<std::uint8_t*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+/**
+ * Linear search, a bundle holds a handful of assets
+ */
+const AssetBundle::Entry* AssetBundle::find(const std::string& name) const {
+    for (std::size_t i = 0; i < entryCount; ++i) {
+        if (name == entries[i].name) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Each new pixel averages the source pixels under it. Colors are weighted
+ * by alpha, otherwise the transparent pixels around a sprite (black, as far
+ * as their color goes) would darken its edges.
+ */
+void AssetBundle::downsample(const std::uint8_t* pixels, unsigned width, unsigned height, unsigned newWidth,
+                             unsigned newHeight, std::vector<std::uint8_t>& resized) {
+    resized.assign(static_cast<std::size_t>(newWidth) * newHeight * 4, 0);
+    for (unsigned y = 0; y < newHeight; ++y) {
+        unsigned top = static_cast<unsigned>(static_cast<std::uint64_t>(y) * height / newHeight);
+        unsigned bottom = std::max(top + 1, static_cast<unsigned>(static_cast<std::uint64_t>(y + 1) * height / newHeight));
+        for (unsigned x = 0; x < newWidth; ++x) {
+            unsigned left = static_cast<unsigned>(static_cast<std::uint64_t>(x) * width / newWidth);
+            unsigned right = std::max(left + 1, static_cast<unsigned>(static_cast<std::uint64_t>(x + 1) * width / newWidth));
+            std::uint64_t red = 0;
+            std::uint64_t green = 0;
+            std::uint64_t blue = 0;
+            std::uint64_t alpha = 0;
+            for (unsigned sy = top; sy < bottom; ++sy) {
+                const std::uint8_t* pixel = pixels + (static_cast<std::size_t>(sy) * width + left) * 4;
+                for (unsigned sx = left; sx < right; ++sx, pixel += 4) {
+                    red += static_cast<std::uint64_t>(pixel[0]) * pixel[3];
+                    green += static_cast<std::uint64_t>(pixel[1]) * pixel[3];
+                    blue += static_cast<std::uint64_t>(pixel[2]) * pixel[3];
+                    alpha += pixel[3];
+                }
+            }
+            std::uint64_t count = static_cast<std::uint64_t>(bottom - top) * (right - left);
+            std::uint8_t* out = &resized[(static_cast<std::size_t>(y) * newWidth + x) * 4];
+            if (alpha != 0) {
+                out[0] = static_cast<std::uint8_t>((red + alpha / 2) / alpha);
+                out[1] = static_cast<std::uint8_t>((green + alpha / 2) / alpha);
+                out[2] = static_cast<std::uint8_t>((blue + alpha / 2) / alpha);
+            }
+            out[3] = static_cast<std::uint8_t>((alpha + count / 2) / count);
+        }
+    }
+}
+
+void AssetBundleWriter::addImage(const std::string& name, unsigned width, unsigned height,
+                                 const std::uint8_t* pixels) {
+    add(name, width, height, pixels, static_cast<std::size_t>(width) * height * 4);
+}
+
+void AssetBundleWriter::addFile(const std::string& name, const std::vector<std::uint8_t>& bytes) {
+    add(name, 0, 0, bytes.data(), bytes.size());
+}
+
+void AssetBundleWriter::add(const std::string& name, unsigned width, unsigned height, const std::uint8_t* bytes,
+                            std::size_t count) {
+    AssetBundle::Entry entry{};
+    // Names longer than the field are cut, which the baker's paths never are
+    std::strncpy(entry.name, name.c_str(), AssetBundle::NAME_SIZE - 1);
+    entry.width = width;
+    entry.height = height;
+    // relative to the blob until write() knows where it starts
+    entry.offset = blob.size();
+    entry.size = count;
+    entries.push_back(entry);
+    blob.insert(blob.end(), bytes, bytes + count);
+    blob.resize(alignUp(blob.size()), 0);
+}
+/**
+ * Write the header, the entries and then every asset
+ * @return 0 if the whole bundle was written, 1 otherwise
+ */
+int AssetBundleWriter::write(const std::string& path) const {
+    Header header{};
+    std::memcpy(header.magic, AssetBundle::MAGIC, sizeof(header.magic));
+    header.version = AssetBundle::VERSION;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+    std::size_t tableEnd = sizeof(header) + entries.size() * sizeof(AssetBundle::Entry);
+    std::size_t dataStart = alignUp(tableEnd);
+
+    std::vector<AssetBundle::Entry> placed(entries);
+    for (AssetBundle::Entry& entry : placed) {
+        entry.offset += dataStart;
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return 1;
+    }
+    const char padding[ALIGNMENT] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(placed.data()),
+              static_cast<std::streamsize>(placed.size() * sizeof(AssetBundle::Entry)));
+    out.write(padding, static_cast<std::streamsize>(dataStart - tableEnd));
+    out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+    return out ? 0 : 1;
+}
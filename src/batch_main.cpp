@@ -0,0 +1,167 @@
+/*
+ * File: batch_main.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Headless batch runner, plays thousands of games on every core
+ * with the given balance settings and prints how they went.
+ */
+
+#include "batch_runner.h"
+#include "job_system.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage: game_batch [options]\n"
+                 "  --games N               games to play (default 10000)\n"
+                 "  --seed N                batch seed (default random)\n"
+                 "  --threads N             worker threads besides this one (default cores - 1)\n"
+                 "  --policy random|chase   how the player is steered (default random)\n"
+                 "  --csv FILE              write every game's result to FILE\n"
+                 "  --max-ghosts N          --max-fruits N\n"
+                 "  --ghost-delay MIN MAX   --fruit-delay MIN MAX   spawn delays in seconds\n"
+                 "  --speed BASE BOOSTED    player speed in pixels per tick\n"
+                 "  --boost SECONDS         --time SECONDS\n"
+                 "  --world-scale N         world N screens wide and high (default 1)\n"
+                 "  --ghost-behavior COLOR wander|chase|flee\n"
+                 "                          how ghosts of a color move (blue, orange, pink or red),\n"
+                 "                          all wander by default\n";
+}
+
+void printStats(const BatchStats& stats, float seconds) {
+    std::printf("games            %zu in %.2f s (%.0f games/min)\n", stats.games, seconds,
+                seconds > 0 ? stats.games * 60.0 / seconds : 0.0);
+    std::printf("score            mean %.2f  stddev %.2f\n", stats.meanScore, stats.scoreStdDev);
+    std::printf("                 min %d  p10 %d  median %d  p90 %d  max %d\n", stats.minScore, stats.p10Score,
+                stats.medianScore, stats.p90Score, stats.maxScore);
+    std::printf("ghosts eaten     mean %.2f  max %d\n", stats.meanGhostsEaten, stats.maxGhostsEaten);
+    std::printf("boost uptime     mean %.1f%%\n", stats.meanBoostUptime * 100.0);
+
+    std::size_t tallest = 1;
+    for (std::size_t games : stats.histogram) {
+        tallest = std::max(tallest, games);
+    }
+    std::printf("score distribution\n");
+    for (std::size_t i = 0; i < stats.histogram.size(); ++i) {
+        int low = static_cast<int>(i) * stats.histogramBucketWidth;
+        auto bar = static_cast<int>(stats.histogram[i] * 50 / tallest);
+        std::printf("  %5d-%-5d %8zu %s\n", low, low + stats.histogramBucketWidth - 1, stats.histogram[i],
+                    std::string(bar, '#').c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t games = 10000;
+    std::uint64_t seed = Rng::randomSeed();
+    unsigned threads = JobSystem::defaultWorkerCount();
+    InputPolicy::Kind policy = InputPolicy::RANDOM;
+    std::string csvPath;
+    SimConfig config;
+
+    // Options taking one or two values, checked before reading them
+    for (int i = 1; i < argc; ++i) {
+        auto option = [&](const char* name, int values) {
+            if (std::strcmp(argv[i], name) != 0) {
+                return false;
+            }
+            if (i + values >= argc) {
+                throw std::invalid_argument(std::string("missing value for ") + name);
+            }
+            return true;
+        };
+        try {
+            if (option("--games", 1)) {
+                games = std::stoull(argv[++i]);
+            } else if (option("--seed", 1)) {
+                seed = std::stoull(argv[++i]);
+            } else if (option("--threads", 1)) {
+                threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else if (option("--policy", 1)) {
+                std::string name = argv[++i];
+                if (name == "random") {
+                    policy = InputPolicy::RANDOM;
+                } else if (name == "chase") {
+                    policy = InputPolicy::CHASE;
+                } else {
+                    throw std::invalid_argument("unknown policy " + name);
+                }
+            } else if (option("--csv", 1)) {
+                csvPath = argv[++i];
+            } else if (option("--max-ghosts", 1)) {
+                config.maxGhosts = std::stoi(argv[++i]);
+            } else if (option("--max-fruits", 1)) {
+                config.maxFruits = std::stoi(argv[++i]);
+            } else if (option("--ghost-delay", 2)) {
+                config.ghostSpawnDelayMin = std::stof(argv[++i]);
+                config.ghostSpawnDelayMax = std::stof(argv[++i]);
+            } else if (option("--fruit-delay", 2)) {
+                config.fruitSpawnDelayMin = std::stof(argv[++i]);
+                config.fruitSpawnDelayMax = std::stof(argv[++i]);
+            } else if (option("--speed", 2)) {
+                config.basePlayerSpeed = std::stof(argv[++i]);
+                config.boostedPlayerSpeed = std::stof(argv[++i]);
+            } else if (option("--boost", 1)) {
+                config.boostDuration = sf::seconds(std::stof(argv[++i]));
+            } else if (option("--time", 1)) {
+                config.totalTime = sf::seconds(std::stof(argv[++i]));
+            } else if (option("--world-scale", 1)) {
+                config.worldScale = std::stoi(argv[++i]);
+                if (config.worldScale < 1) {
+                    throw std::invalid_argument("--world-scale must be at least 1");
+                }
+            } else if (option("--ghost-behavior", 2)) {
+                const char* colors[Ghost::COLOR_COUNT] = {"blue", "orange", "pink", "red"};
+                const char* behaviors[3] = {"wander", "chase", "flee"};
+                std::string color = argv[++i];
+                std::string behavior = argv[++i];
+                auto colorIndex = std::find(std::begin(colors), std::end(colors), color) - std::begin(colors);
+                auto behaviorIndex =
+                        std::find(std::begin(behaviors), std::end(behaviors), behavior) - std::begin(behaviors);
+                if (colorIndex == Ghost::COLOR_COUNT || behaviorIndex == 3) {
+                    throw std::invalid_argument("unknown ghost behavior " + color + " " + behavior);
+                }
+                config.ghostBehaviors[colorIndex] = static_cast<GhostBehavior>(behaviorIndex);
+            } else {
+                throw std::invalid_argument(std::string("unknown option ") + argv[i]);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    JobSystem jobs(threads);
+    BatchRunner runner(config, policy);
+    std::printf("seed             %llu\n", static_cast<unsigned long long>(seed));
+    std::printf("threads          %u\n", jobs.getWorkerCount() + 1);
+
+    sf::Clock clock;
+    const std::vector<GameResult>& results = runner.run(games, seed, jobs);
+    float seconds = clock.getElapsedTime().asSeconds();
+    printStats(BatchRunner::summarize(results), seconds);
+
+    if (!csvPath.empty()) {
+        std::ofstream csv(csvPath);
+        if (!csv) {
+            std::cerr << "Could not write " << csvPath << std::endl;
+            return 1;
+        }
+        csv << "seed,score,ghosts_eaten,boost_uptime\n";
+        for (const auto& result : results) {
+            csv << result.seed << ',' << result.score << ',' << result.ghostsEaten << ',' << result.boostUptime << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * File: batch_runner.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: BatchRunner class, plays many headless games in parallel and
+ * sums up how they went, for balance tuning.
+ */
+
+#include "batch_runner.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// How long the random policy keeps a direction, in ticks
+const int InputPolicy::MIN_HOLD_TICKS = 30;
+const int InputPolicy::MAX_HOLD_TICKS = 120;
+// Enough chunks for every thread to steal a few when its own games run long
+const std::size_t BatchRunner::CHUNKS_PER_THREAD = 8;
+
+/**
+ * InputPolicy constructor, the seed is separate from the game's own
+ */
+InputPolicy::InputPolicy(Kind kind, std::uint64_t seed) : kind(kind), rng(seed, 1), held(INPUT_NONE), holdTicks(0) {
+}
+
+/**
+ * Directions to hold during the next tick of the given game
+ */
+std::uint8_t InputPolicy::next(const GameSim& sim) {
+    if (kind == CHASE) {
+        return chase(sim);
+    }
+    return wander();
+}
+/**
+ * Keep going the same way until the hold runs out, then pick a new way
+ */
+std::uint8_t InputPolicy::wander() {
+    if (holdTicks <= 0) {
+        held = static_cast<std::uint8_t>(1 << rng.uniformInt(0, 3));
+        holdTicks = rng.uniformInt(MIN_HOLD_TICKS, MAX_HOLD_TICKS);
+    }
+    --holdTicks;
+    return held;
+}
+/**
+ * Step along the longer axis towards the closest ghost
+ */
+std::uint8_t InputPolicy::chase(const GameSim& sim) {
+    const GhostStore& ghosts = sim.getGhosts();
+    if (ghosts.empty()) {
+        return wander();
+    }
+    const sf::Vector2f& player = sim.getPlayerPosition();
+    float bestDistance = std::numeric_limits<float>::max();
+    sf::Vector2f best;
+    for (std::size_t i = 0; i < ghosts.size(); ++i) {
+        sf::Vector2f offset = ghosts.getPosition(i) - player;
+        float distance = offset.x * offset.x + offset.y * offset.y;
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = offset;
+        }
+    }
+    if (std::abs(best.x) > std::abs(best.y)) {
+        return best.x > 0 ? INPUT_RIGHT : INPUT_LEFT;
+    }
+    return best.y > 0 ? INPUT_DOWN : INPUT_UP;
+}
+
+
+/**
+ * BatchRunner constructor, every game of the batch is played with the same rules and policy
+ */
+BatchRunner::BatchRunner(const SimConfig& config, InputPolicy::Kind policy) : config(config), policy(policy) {
+}
+
+/**
+ * Play the given number of games on the job system
+ * @return the result of every game, in game order
+ */
+const std::vector<GameResult>& BatchRunner::run(std::size_t games, std::uint64_t batchSeed, JobSystem& jobs) {
+    results.assign(games, GameResult());
+    std::size_t threads = jobs.getWorkerCount() + 1;
+    std::size_t chunkSize = std::max<std::size_t>(1, games / (threads * CHUNKS_PER_THREAD));
+
+    jobs.parallelFor(games, chunkSize, [this, batchSeed](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            results[i] = playGame(gameSeed(batchSeed, i), config, policy);
+        }
+    });
+    return results;
+}
+/**
+ * Seed of one game in a batch, only depends on the batch seed and the game number
+ */
+std::uint64_t BatchRunner::gameSeed(std::uint64_t batchSeed, std::size_t game) {
+    Rng rng(batchSeed, game);
+    return rng.next64();
+}
+/**
+ * Play one game from start to end, with the policy holding the keys
+ */
+GameResult BatchRunner::playGame(std::uint64_t seed, const SimConfig& config, InputPolicy::Kind policy) {
+    GameSim sim(seed, config);
+    InputPolicy player(policy, seed);
+    while (!sim.isGameEnded()) {
+        sim.setInput(player.next(sim));
+        sim.tick();
+    }
+
+    GameResult result;
+    result.seed = seed;
+    result.score = sim.getScore();
+    result.ghostsEaten = sim.getGhostsEaten();
+    result.boostUptime = sim.getTickCount() > 0
+            ? static_cast<float>(sim.getBoostedTicks()) / static_cast<float>(sim.getTickCount()) : 0.0f;
+    return result;
+}
+/**
+ * Score distribution, ghosts eaten and boost uptime over a batch
+ */
+BatchStats BatchRunner::summarize(const std::vector<GameResult>& results, std::size_t histogramBuckets) {
+    BatchStats stats;
+    stats.games = results.size();
+    if (results.empty()) {
+        return stats;
+    }
+
+    std::vector<int> scores;
+    scores.reserve(results.size());
+    double scoreSum = 0;
+    double ghostSum = 0;
+    double boostSum = 0;
+    for (const auto& result : results) {
+        scores.push_back(result.score);
+        scoreSum += result.score;
+        ghostSum += result.ghostsEaten;
+        boostSum += result.boostUptime;
+        stats.maxGhostsEaten = std::max(stats.maxGhostsEaten, result.ghostsEaten);
+    }
+    auto count = static_cast<double>(results.size());
+    stats.meanScore = scoreSum / count;
+    stats.meanGhostsEaten = ghostSum / count;
+    stats.meanBoostUptime = boostSum / count;
+
+    double squaredSum = 0;
+    for (int score : scores) {
+        squaredSum += (score - stats.meanScore) * (score - stats.meanScore);
+    }
+    stats.scoreStdDev = std::sqrt(squaredSum / count);
+
+    std::sort(scores.begin(), scores.end());
+    auto percentile = [&scores](double p) {
+        return scores[static_cast<std::size_t>(p * static_cast<double>(scores.size() - 1) + 0.5)];
+    };
+    stats.minScore = scores.front();
+    stats.p10Score = percentile(0.1);
+    stats.medianScore = percentile(0.5);
+    stats.p90Score = percentile(0.9);
+    stats.maxScore = scores.back();
+
+    // Buckets start at 0 and are wide enough for the best score to land in the last one
+    histogramBuckets = std::max<std::size_t>(1, histogramBuckets);
+    auto buckets = static_cast<int>(histogramBuckets);
+    stats.histogramBucketWidth = std::max(1, (std::max(stats.maxScore, 0) + buckets) / buckets);
+    stats.histogram.assign(histogramBuckets, 0);
+    for (int score : scores) {
+        auto bucket = static_cast<std::size_t>(std::max(score, 0) / stats.histogramBucketWidth);
+        ++stats.histogram[std::min(bucket, histogramBuckets - 1)];
+    }
+    return stats;
+}
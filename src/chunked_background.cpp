@@ -0,0 +1,87 @@
+/*
+ * File: chunked_background.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ChunkedBackground class, the world's background tiles built once into
+ * one vertex array per chunk, and only the chunks in view drawn.
+ */
+
+#include "chunked_background.h"
+#include <algorithm>
+#include <cmath>
+
+// 8x8 tiles of 180px make chunks a bit smaller than the screen, so a view overlaps 4 to 6 of them
+const int ChunkedBackground::CHUNK_TILES = 8;
+
+ChunkedBackground::ChunkedBackground() : texture(nullptr), columns(0), rows(0) {
+}
+
+/**
+ * Lay the tiles over the world, two triangles per tile like SpriteBatch
+ * @return 0 if built, 1 if the tile texture is empty
+ */
+int ChunkedBackground::build(const sf::Texture& tile, const sf::Vector2f& worldSize) {
+    texture = &tile;
+    chunks.clear();
+    sf::Vector2f tileSize(static_cast<float>(tile.getSize().x), static_cast<float>(tile.getSize().y));
+    if (tileSize.x <= 0 || tileSize.y <= 0) {
+        columns = 0;
+        rows = 0;
+        return 1;
+    }
+    chunkSize = tileSize * static_cast<float>(CHUNK_TILES);
+    columns = static_cast<int>(std::ceil(worldSize.x / chunkSize.x));
+    rows = static_cast<int>(std::ceil(worldSize.y / chunkSize.y));
+    chunks.reserve(static_cast<std::size_t>(columns * rows));
+
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            chunks.emplace_back(sf::Triangles);
+            sf::VertexArray& chunk = chunks.back();
+            for (int y = 0; y < CHUNK_TILES; ++y) {
+                for (int x = 0; x < CHUNK_TILES; ++x) {
+                    float left = column * chunkSize.x + x * tileSize.x;
+                    float top = row * chunkSize.y + y * tileSize.y;
+                    if (left >= worldSize.x || top >= worldSize.y) {
+                        continue;
+                    }
+                    float right = std::min(left + tileSize.x, worldSize.x);
+                    float bottom = std::min(top + tileSize.y, worldSize.y);
+                    float width = right - left;
+                    float height = bottom - top;
+                    chunk.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(0, 0)));
+                    chunk.append(sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(width, 0)));
+                    chunk.append(sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(width, height)));
+                    chunk.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(0, 0)));
+                    chunk.append(sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(width, height)));
+                    chunk.append(sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(0, height)));
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Draw the chunks overlapping the visible rectangle, found from its corners
+ * rather than by testing every chunk
+ */
+std::size_t ChunkedBackground::draw(sf::RenderTarget& target, const sf::FloatRect& visible) const {
+    if (chunks.empty()) {
+        return 0;
+    }
+    int firstColumn = std::max(0, static_cast<int>(std::floor(visible.left / chunkSize.x)));
+    int lastColumn = std::min(columns - 1, static_cast<int>(std::floor((visible.left + visible.width) / chunkSize.x)));
+    int firstRow = std::max(0, static_cast<int>(std::floor(visible.top / chunkSize.y)));
+    int lastRow = std::min(rows - 1, static_cast<int>(std::floor((visible.top + visible.height) / chunkSize.y)));
+
+    std::size_t drawn = 0;
+    sf::RenderStates states(texture);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            target.draw(chunks[static_cast<std::size_t>(row * columns + column)], states);
+            ++drawn;
+        }
+    }
+    return drawn;
+}
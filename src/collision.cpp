@@ -0,0 +1,169 @@
+/*
+ * File: collision.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Collision class with scalar, SSE and AVX2 versions of the
+ * player-vs-entity circle test
+ */
+
+#include "collision.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define COLLISION_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions in functions that ask for them
+#if defined(COLLISION_X86) && (defined(__GNUC__) || defined(__clang__))
+#define COLLISION_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define COLLISION_TARGET_AVX2
+#endif
+
+/**
+ * Find hits with the fastest backend this CPU supports
+ * @return the number of hits written
+ */
+std::size_t Collision::findHits(const float* xs, const float* ys, std::size_t count,
+                                float x, float y, float radius, std::uint32_t* hits) {
+    static const Backend backend = getBackend();
+    return findHits(backend, xs, ys, count, x, y, radius, hits);
+}
+/**
+ * Find hits with a given backend, which must be supported
+ * @return the number of hits written
+ */
+std::size_t Collision::findHits(Backend backend, const float* xs, const float* ys, std::size_t count,
+                                float x, float y, float radius, std::uint32_t* hits) {
+    float radiusSq = radius * radius;
+    switch (backend) {
+        case AVX2:
+            return findHitsAvx2(xs, ys, count, x, y, radiusSq, hits);
+        case SSE:
+            return findHitsSse(xs, ys, count, x, y, radiusSq, hits);
+        default:
+            return findHitsScalar(xs, ys, 0, count, x, y, radiusSq, hits);
+    }
+}
+
+
+/**
+ * Widest backend the running CPU can execute
+ */
+Collision::Backend Collision::getBackend() {
+    if (isSupported(AVX2)) {
+        return AVX2;
+    }
+    if (isSupported(SSE)) {
+        return SSE;
+    }
+    return SCALAR;
+}
+/**
+ * Check if the running CPU can execute a backend
+ */
+bool Collision::isSupported(Backend backend) {
+    switch (backend) {
+        case SCALAR:
+            return true;
+#if defined(COLLISION_X86) && (defined(__GNUC__) || defined(__clang__))
+        case SSE:
+            return __builtin_cpu_supports("sse2");
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+#elif defined(COLLISION_X86) && defined(_MSC_VER)
+        case SSE: {
+            int info[4];
+            __cpuid(info, 1);
+            return (info[3] & (1 << 26)) != 0;
+        }
+        case AVX2: {
+            int info[4];
+            __cpuid(info, 1);
+            // The OS has to save the YMM registers too
+            bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(info, 7, 0);
+            return osSavesYmm && (info[1] & (1 << 5)) != 0;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+
+/**
+ * One entity at a time, also used for the tail the vector loops leave over
+ */
+std::size_t Collision::findHitsScalar(const float* xs, const float* ys, std::size_t begin, std::size_t count,
+                                      float x, float y, float radiusSq, std::uint32_t* hits) {
+    std::size_t found = 0;
+    for (std::size_t i = begin; i < count; ++i) {
+        float dx = xs[i] - x;
+        float dy = ys[i] - y;
+        if (dx * dx + dy * dy < radiusSq) {
+            hits[found++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return found;
+}
+/**
+ * Four entities per instruction
+ */
+std::size_t Collision::findHitsSse(const float* xs, const float* ys, std::size_t count,
+                                   float x, float y, float radiusSq, std::uint32_t* hits) {
+    std::size_t found = 0;
+    std::size_t i = 0;
+#ifdef COLLISION_X86
+    const __m128 px = _mm_set1_ps(x);
+    const __m128 py = _mm_set1_ps(y);
+    const __m128 limit = _mm_set1_ps(radiusSq);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), px);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), py);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(distSq, limit));
+        while (mask != 0) {
+            int bit = 0;
+            while (((mask >> bit) & 1) == 0) {
+                ++bit;
+            }
+            hits[found++] = static_cast<std::uint32_t>(i + bit);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    return found + findHitsScalar(xs, ys, i, count, x, y, radiusSq, hits + found);
+}
+/**
+ * Eight entities per instruction
+ */
+COLLISION_TARGET_AVX2
+std::size_t Collision::findHitsAvx2(const float* xs, const float* ys, std::size_t count,
+                                    float x, float y, float radiusSq, std::uint32_t* hits) {
+    std::size_t found = 0;
+    std::size_t i = 0;
+#ifdef COLLISION_X86
+    const __m256 px = _mm256_set1_ps(x);
+    const __m256 py = _mm256_set1_ps(y);
+    const __m256 limit = _mm256_set1_ps(radiusSq);
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), px);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), py);
+        __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(distSq, limit, _CMP_LT_OQ));
+        while (mask != 0) {
+            int bit = 0;
+            while (((mask >> bit) & 1) == 0) {
+                ++bit;
+            }
+            hits[found++] = static_cast<std::uint32_t>(i + bit);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    return found + findHitsScalar(xs, ys, i, count, x, y, radiusSq, hits + found);
+}
@@ -0,0 +1,171 @@
+/*
+ * File: flow_field.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: FlowField class, breadth-first distance field over the world
+ * grid, rebuilt when its target changes cell
+ */
+
+#include "flow_field.h"
+#include <cmath>
+#include <cstdlib>
+
+// Indexed by Step
+const float FlowField::STEP_X[5] = {0.0f, 0.0f, 0.0f, -1.0f, 1.0f};
+const float FlowField::STEP_Y[5] = {0.0f, -1.0f, 1.0f, 0.0f, 0.0f};
+
+/**
+ * FlowField constructor, the only place its buffers are allocated
+ */
+FlowField::FlowField(float width, float height, float cellSize)
+        : inverseCellSize(1.0f / cellSize),
+          columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+          rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+          distance(static_cast<std::size_t>(columns) * rows, 0),
+          nearest(distance.size(), 0),
+          toward(distance.size(), STAY),
+          away(distance.size(), STAY) {
+    frontier.reserve(distance.size());
+}
+
+/**
+ * Point the field at new targets, which only costs a rebuild if one of them left its cell
+ * @return true if the field was rebuilt
+ */
+bool FlowField::update(const sf::Vector2f* targets, std::size_t count) {
+    bool moved = count != targetCells.size();
+    // Only allocates the first time, or if there are ever more targets
+    targetCells.resize(count);
+    targetColumns.resize(count);
+    targetRows.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int x = column(targets[i].x);
+        int y = row(targets[i].y);
+        auto cell = static_cast<std::uint32_t>(y * columns + x);
+        moved = moved || cell != targetCells[i];
+        targetCells[i] = cell;
+        targetColumns[i] = x;
+        targetRows[i] = y;
+    }
+    if (!moved) {
+        return false;
+    }
+    rebuild();
+    return true;
+}
+
+/**
+ * Breadth-first search from every target cell at once, then the best steps of every cell.
+ * Every cell is open for now, so a cell's steps follow from where its nearest
+ * target is and only the search would have to change for walls. Both passes
+ * know each cell's column and row as they go, so neither divides by the row
+ * length.
+ */
+void FlowField::rebuild() {
+    const std::uint16_t unreached = 0xFFFF;
+    std::fill(distance.begin(), distance.end(), unreached);
+    frontier.clear();
+    for (std::size_t i = 0; i < targetCells.size(); ++i) {
+        std::uint32_t target = targetCells[i];
+        // Two targets can share a cell
+        if (distance[target] != 0) {
+            distance[target] = 0;
+            nearest[target] = static_cast<std::uint32_t>(i);
+            frontier.push_back(static_cast<std::uint32_t>(targetColumns[i]) |
+                               static_cast<std::uint32_t>(targetRows[i]) << 16u);
+        }
+    }
+    for (std::size_t next = 0; next < frontier.size(); ++next) {
+        auto x = static_cast<int>(frontier[next] & 0xFFFFu);
+        auto y = static_cast<int>(frontier[next] >> 16u);
+        int cell = y * columns + x;
+        std::uint16_t neighborDistance = distance[cell] + 1;
+        std::uint32_t from = nearest[cell];
+        auto visit = [&](int neighbor, int neighborX, int neighborY) {
+            if (distance[neighbor] == unreached) {
+                distance[neighbor] = neighborDistance;
+                nearest[neighbor] = from;
+                frontier.push_back(static_cast<std::uint32_t>(neighborX) | static_cast<std::uint32_t>(neighborY) << 16u);
+            }
+        };
+        if (y > 0) {
+            visit(cell - columns, x, y - 1);
+        }
+        if (y < rows - 1) {
+            visit(cell + columns, x, y + 1);
+        }
+        if (x > 0) {
+            visit(cell - 1, x - 1, y);
+        }
+        if (x < columns - 1) {
+            visit(cell + 1, x + 1, y);
+        }
+    }
+    int cell = 0;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x, ++cell) {
+            pickSteps(cell, x, y);
+        }
+    }
+}
+/**
+ * The steps that get closer to and further from the nearest target. When
+ * both axes are as good, the one the target is furthest along goes first, so
+ * paths come out as staircases instead of L shapes. Among neighbors that are
+ * as good, the one up or left goes first.
+ */
+void FlowField::pickSteps(int cell, int x, int y) {
+    std::uint32_t target = nearest[cell];
+    int offsetX = targetColumns[target] - x;
+    int offsetY = targetRows[target] - y;
+    bool horizontalFirst = std::abs(offsetX) >= std::abs(offsetY);
+    int offset = horizontalFirst ? offsetX : offsetY;
+    int position = horizontalFirst ? x : y;
+    int size = horizontalFirst ? columns : rows;
+    int stride = horizontalFirst ? 1 : columns;
+    Step back = horizontalFirst ? LEFT : UP;
+    Step forward = horizontalFirst ? RIGHT : DOWN;
+    int here = distance[cell];
+
+    // Heading for the nearest target always gets a cell closer, the way back
+    // can too if another target is as near
+    if (offset == 0) {
+        toward[cell] = STAY;
+    } else if (offset < 0 || (position > 0 && distance[cell - stride] < here)) {
+        toward[cell] = back;
+    } else {
+        toward[cell] = forward;
+    }
+    // Leaving it behind gets a cell further unless that's the edge of the
+    // world or nearer another target, only then are the other neighbors looked at
+    int leave = offset > 0 || (offset == 0 && position > 0) ? -1 : 1;
+    if (position + leave >= 0 && position + leave < size && distance[cell + leave * stride] > here) {
+        away[cell] = leave < 0 ? back : forward;
+    } else {
+        away[cell] = furthestNeighbor(cell, x, y, horizontalFirst);
+    }
+}
+/**
+ * First neighbor in the same order that is further from every target than
+ * this cell, STAY if none is
+ */
+FlowField::Step FlowField::furthestNeighbor(int cell, int x, int y, bool horizontalFirst) const {
+    const Step vertical[2] = {UP, DOWN};
+    const Step horizontal[2] = {LEFT, RIGHT};
+    const int verticalCells[2] = {y > 0 ? cell - columns : -1, y < rows - 1 ? cell + columns : -1};
+    const int horizontalCells[2] = {x > 0 ? cell - 1 : -1, x < columns - 1 ? cell + 1 : -1};
+
+    Step best = STAY;
+    int bestDistance = distance[cell];
+    for (int axis = 0; axis < 2; ++axis) {
+        bool useHorizontal = (axis == 0) == horizontalFirst;
+        for (int side = 0; side < 2; ++side) {
+            int neighbor = useHorizontal ? horizontalCells[side] : verticalCells[side];
+            if (neighbor >= 0 && distance[neighbor] > bestDistance) {
+                best = useHorizontal ? horizontal[side] : vertical[side];
+                bestDistance = distance[neighbor];
+            }
+        }
+    }
+    return best;
+}
@@ -7,320 +7,441 @@
  */
 
 #include "game.h"
+#include <algorithm>
+#include <iostream>
 
-const float Game::SCENE_WIDTH = 1920.0f;
-const float Game::SCENE_HEIGHT = 1280.0f;
-const float Game::PLAYER_START_X = 960.0f;
-const float Game::PLAYER_START_Y = 640.0f;
-const float Game::RADIUS = 40.0f;
-const int Game::MAX_GHOSTS = 10;
-const int Game::MAX_FRUITS = 3;
-const float Game::COLLISION_THRESHOLD = 80;
-const float Game::BASE_P_SPEED = 5.0f;
-const float Game::BOOSTED_P_SPEED = 8.0f;
+const sf::Time Game::MAX_FRAME_TIME = sf::milliseconds(250);
+// 5 seconds at 120 Hz
+const std::size_t Game::REWIND_TICKS = 600;
+#ifdef GAME_PROFILING
+const char* const Game::TRACE_PATH = "trace.json";
+#endif
 
-Game::Game() : score(0), totalTime(sf::seconds(23)), gameEnded(false) {
+Game::Game(const SimConfig& config) : Game(std::unique_ptr<TimeSource>(new RealTimeSource()), config) {
+}
+
+Game::Game(std::unique_ptr<TimeSource> timeSource, const SimConfig& config)
+        : sim(Rng::randomSeed(), config), timeSource(std::move(timeSource)), rewind(REWIND_TICKS) {
+    sim.setJobSystem(&jobs);
+    sim.save(startState);
+    rewind.reserve(sim);
+    for (int i = 0; i < 3; ++i) {
+        snapshots.getCopy(i).reserve(sim.getConfig());
+    }
     initWindow();
+    initResources();
     initBackground();
-    initScore();
+    initHud();
     initPlayer();
-    nextSpawnTime = randSpawnDelay(0);
+}
+
+Game::~Game() {
+    stopSimulation();
 }
 
 /**
  * Window initializer.
  */
 int Game::initWindow() {
-    window.create(sf::VideoMode(SCENE_WIDTH, SCENE_HEIGHT), "PacMan Lite");
-    window.setFramerateLimit(120);
+    window.create(sf::VideoMode(getSceneWidth(), getSceneHeight()), "PacMan Lite");
+    camera.setSize(getSceneWidth(), getSceneHeight());
+    followPlayer(sim.getPlayerPosition());
+    // Frames follow the display, the simulation keeps its own pace on its thread
+    window.setVerticalSyncEnabled(true);
+    // Only real presses and releases, a held key is tracked from its press
+    window.setKeyRepeatEnabled(false);
     return 0;
 }
 /**
- * Background initializer.
+ * Load every asset up front, so nothing touches the disk once the game is running
+ * @return 0 if successfully initialized, 1 otherwise
  */
-int Game::initBackground() {
-    if (!backgroundTexture.loadFromFile("resources/background.png")) {
-        return 1;
+int Game::initResources() {
+    resourcesLoaded = resources.loadAll();
+    for (const auto& error : resources.getErrors()) {
+        std::cerr << error << std::endl;
     }
-    backgroundTexture.setRepeated(true);
-    background.setTexture(backgroundTexture);
-    background.setTextureRect(sf::IntRect(0, 0, SCENE_WIDTH, SCENE_HEIGHT));
-    return 0;
+    return resourcesLoaded ? 0 : 1;
 }
 /**
- * Score initializer
+ * Background initializer, tiles the whole world
  * @return 0 if successfully initialized, 1 otherwise
  */
-int Game::initScore() {
-    if (!font.loadFromFile("resources/CyberpunkWaifus.ttf")) {
-        return 1;
-    }
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(42);
-    scoreText.setFillColor(sf::Color::White);
-    scoreText.setPosition(10.f, 10.f);
-    return 0;
+int Game::initBackground() {
+    return background.build(resources.getTexture(ResourceManager::BACKGROUND), sim.getWorldSize());
+}
+/**
+ * Texts over the game initializer
+ * @return 0 if successfully initialized, 1 otherwise
+ */
+int Game::initHud() {
+#ifdef GAME_PROFILING
+    profilerOverlay.init(resources.getFont(ResourceManager::MAIN_FONT), sf::Vector2f(10.f, 70.f));
+#endif
+    return hud.init(resources.getFont(ResourceManager::MAIN_FONT), getSceneWidth(), getSceneHeight());
 }
 /**
  * PacMan initializer
  * @return 0 if successfully initialized, 1 otherwise
  */
 int Game::initPlayer() {
-    player.setRadius(RADIUS);
-    player.setOrigin(RADIUS, RADIUS);
-    player.setPosition(PLAYER_START_X, PLAYER_START_Y);
-    if (!playerTexture.loadFromFile("resources/pacman.png")) {
-        return 1;
-    }
-    player.setTexture(&playerTexture);
+    float radius = GameSim::getPlayerRadius();
+    player.setRadius(radius);
+    player.setOrigin(radius, radius);
+    player.setPosition(sim.getPlayerPosition());
+    player.setTexture(&resources.getTexture(ResourceManager::PLAYER));
+    rival.setRadius(radius);
+    rival.setOrigin(radius, radius);
+    rival.setTexture(&resources.getTexture(ResourceManager::PLAYER));
+    // Same pacman, tinted so it isn't mistaken for ours
+    rival.setFillColor(sf::Color(255, 140, 140));
     return 0;
 }
+
 /**
- * Display the countdown for the game duration
- * @return 0 if successfully initialized, 1 otherwise
+ * Record the session to a file, replayable with --replay
+ * @return 0 if the file could be opened, 1 otherwise
  */
-int Game::clockRender() {
-    if (!font.loadFromFile("resources/CyberpunkWaifus.ttf")) {
-        return 1;
-    }
-    countdownText.setFont(font);
-    countdownText.setCharacterSize(42);
-    countdownText.setFillColor(sf::Color::White);
-    countdownText.setPosition(Game::getSceneWidth() - 200.f, 10.f);
-    return 0;
+int Game::startRecording(const std::string& path) {
+    return recorder.open(path, sim.getSeed(), sim.getConfig().worldScale);
 }
-int Game::finalScoreRender() {
-    if (!font.loadFromFile("resources/CyberpunkWaifus.ttf")) {
-        return 1;
-    }
-    finalScoreText.setFont(font);
-    finalScoreText.setCharacterSize(100);
-    finalScoreText.setFillColor(sf::Color::White);
-    finalScoreText.setString("Game Over! Score: " + std::to_string(score));
-    finalScoreText.setOrigin(finalScoreText.getLocalBounds().width / 2, finalScoreText.getLocalBounds().height / 2);
-    finalScoreText.setPosition(sf::Vector2f(Game::getSceneWidth()/2.0f, Game::getSceneHeight()/2.0f - 30.0f));
-    return 0;
+/**
+ * Hand the game over to a server. Rewinding, restarting and recording are
+ * the server's business then, the local game is only kept for its world size.
+ */
+void Game::playOnServer(std::unique_ptr<NetClient> client) {
+    server = std::move(client);
+    serverLatencies.assign(InputQueue::LATENCY_SAMPLES, sf::Time::Zero);
+    hud.setRestartHint("The next game starts shortly");
 }
 
-
 /**
- * Dealing with events on window.
+ * Direction a key moves the player in, INPUT_NONE for other keys
+ */
+std::uint8_t Game::keyDirection(sf::Keyboard::Key key) {
+    switch (key) {
+        case sf::Keyboard::Up:
+        case sf::Keyboard::W:
+            return INPUT_UP;
+        case sf::Keyboard::Down:
+        case sf::Keyboard::S:
+            return INPUT_DOWN;
+        case sf::Keyboard::Left:
+        case sf::Keyboard::A:
+            return INPUT_LEFT;
+        case sf::Keyboard::Right:
+        case sf::Keyboard::D:
+            return INPUT_RIGHT;
+        default:
+            return INPUT_NONE;
+    }
+}
+/**
+ * Dealing with events on window, direction key presses and releases are stamped and
+ * queued for the simulation to apply at the tick they happened in.
  */
 void Game::processInput() {
+    PROFILE_SCOPE("Game::processInput");
     sf::Event event;
     while (window.pollEvent(event)) {
+        sf::Time time = timeSource->now();
         switch (event.type) {
             case sf::Event::Closed:
                 window.close();
                 break;
+            case sf::Event::LostFocus:
+                input.releaseAll(time);
+                rewinding.store(false, std::memory_order_relaxed);
+                break;
+            case sf::Event::KeyReleased:
+                input.keyChanged(keyDirection(event.key.code), false, time);
+                if (event.key.code == sf::Keyboard::Backspace) {
+                    rewinding.store(false, std::memory_order_relaxed);
+                }
+                break;
+            case sf::Event::KeyPressed:
+                input.keyChanged(keyDirection(event.key.code), true, time);
+                if (event.key.code == sf::Keyboard::Backspace) {
+                    rewinding.store(true, std::memory_order_relaxed);
+                } else if (event.key.code == sf::Keyboard::Enter) {
+                    restartRequested.store(true, std::memory_order_relaxed);
+                }
+#ifdef GAME_PROFILING
+                if (event.key.code == sf::Keyboard::F3) {
+                    showProfiler = !showProfiler;
+                } else if (event.key.code == sf::Keyboard::F4) {
+                    if (Profiler::get().dumpChromeTrace(TRACE_PATH) == 0) {
+                        std::cout << "Profile written to " << TRACE_PATH << std::endl;
+                    } else {
+                        std::cerr << "Could not write " << TRACE_PATH << std::endl;
+                    }
+                }
+#endif
+                break;
             default:
                 break;
         }
     }
 }
 /**
- * Function to update the position of the player
+ * Print how long direction key changes took to reach the screen
  */
-void Game::update() {
-    float x = player.getPosition().x;
-    float y = player.getPosition().y;
-    float player_speed = pSpeed();
-    player.setPosition(x, y);
-
-    // Check if game is going on
-    if (!gameEnded) {
-        sf::Time timeLeft = totalTime - gameClock.getElapsedTime();
-        if (timeLeft <= sf::seconds(0)) {
-            gameEnded = true;
-            timeLeft = sf::seconds(0);
-
-            // Clear ghosts and fruits
-            ghosts.clear();
-            fruits.clear();
-
-            finalScoreText.setString("Game Over! Score: " + std::to_string(score));
-        }
-
-        // Update the countdown text
-        countdownText.setString("Time: " + std::to_string(static_cast<int>(timeLeft.asSeconds())));
-
-        if (!gameEnded) {
-            // Movement
-            if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::W)) && player.getPosition().y > RADIUS) {
-                player.move(0, -player_speed);
-            } else if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || sf::Keyboard::isKeyPressed(sf::Keyboard::S)) && player.getPosition().y < SCENE_HEIGHT - RADIUS) {
-                player.move(0, player_speed);
-            } else if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::A)) && player.getPosition().x > RADIUS) {
-                player.move(-player_speed, 0);
-            } else if ((sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::D)) && player.getPosition().x < SCENE_WIDTH - RADIUS) {
-                player.move(player_speed, 0);
-            }
-        }
+void Game::reportLatency() const {
+    InputQueue::LatencyReport report = input.getLatencyReport();
+    if (report.samples == 0) {
+        return;
+    }
+    std::cout << "input to display latency over " << report.samples << " key changes: median "
+              << report.median.asMicroseconds() / 1000.0 << " ms, p95 " << report.p95.asMicroseconds() / 1000.0
+              << " ms, max " << report.max.asMicroseconds() / 1000.0 << " ms" << std::endl;
+    if (!server) {
+        return;
     }
+    report = InputQueue::summarize(serverLatencies, serverLatencyCount);
+    std::cout << "server states: " << server->getBytesPerTick() << " bytes per tick over "
+              << server->getStatesReceived() << " states" << std::endl;
+    if (report.samples != 0) {
+        std::cout << "input to server tick to display latency over " << report.samples << " states: median "
+                  << report.median.asMicroseconds() / 1000.0 << " ms, p95 "
+                  << report.p95.asMicroseconds() / 1000.0 << " ms, max " << report.max.asMicroseconds() / 1000.0
+                  << " ms" << std::endl;
+    }
+}
+/**
+ * Print how long it took from creating the game to its first frame, and the share of loading assets
+ */
+void Game::reportStartup() const {
+    std::cout << "cold start: first frame after " << startupClock.getElapsedTime().asMicroseconds() / 1000.0
+              << " ms, assets loaded in " << resources.getLoadTime().asMicroseconds() / 1000.0 << " ms ("
+              << resources.getBundledCount() << " of " << ResourceManager::getAssetCount() << " from "
+              << ResourceManager::BUNDLE_FILE << ")" << std::endl;
 }
 
 
 /**
- * Random spawn delay for ghost creation
+ * Publish the starting state and start ticking on the simulation thread
  */
-float Game::randSpawnDelay(int type) {
-    std::random_device rd;
-    std::mt19937 eng(rd());
-    if (type == 0) { // For Ghosts, shorter spawn delay
-        std::uniform_real_distribution<> distr(0.0, 1.5); // Range is 0.0 to 2.0 seconds
-        return distr(eng);
-    } else { // For Fruits, longer spawn delay
-        std::uniform_real_distribution<> distr(5.0, 9.0);
-        return distr(eng);
+void Game::startSimulation() {
+    if (server) {
+        server->capture(snapshots.getBack(), timeSource->now());
+    } else {
+        snapshots.getBack().capture(sim, timeSource->now());
     }
+    snapshots.publish();
+    snapshots.update();
+    simRunning.store(true, std::memory_order_release);
+    simThread = std::thread(&Game::simulate, this);
 }
 /**
- * Check if there are MAX_* (for a given object) in game, if there are less
- * make new ones
+ * Stop the simulation thread and wait for its last tick
  */
-void Game::checkObjNum() {
-    auto playerPosition = player.getPosition();
-
-    if (ghostSpawnClock.getElapsedTime().asSeconds() >= nextSpawnTime && ghosts.size() < MAX_GHOSTS) {
-        ghosts.emplace_back(playerPosition);
-        ghostSpawnClock.restart();
-        nextSpawnTime = randSpawnDelay(0); // Set next spawn delay
-    }
-    // Check if it's time to spawn a new fruit
-    if (fruitSpawnClock.getElapsedTime().asSeconds() >= nextFruitSpawnTime && fruits.size() < MAX_FRUITS) {
-        fruits.emplace_back(playerPosition);
-        fruitSpawnClock.restart();
-        nextFruitSpawnTime = randSpawnDelay(1); // Using existing method
+void Game::stopSimulation() {
+    simRunning.store(false, std::memory_order_release);
+    if (simThread.joinable()) {
+        simThread.join();
     }
 }
-
-
 /**
- * Check if player is colliding with ghost
+ * Simulation thread, runs the ticks that came due and publishes a snapshot,
+ * then sleeps until the next tick is due. While rewinding, each tick that
+ * comes due restores the previous tick's state instead of playing a new one.
+ * On a server, each tick sends the input and predicts the player instead.
  */
-void Game::checkCollisions() {
-    auto playerPos = player.getPosition();
-    auto it = ghosts.begin();
-    while (it != ghosts.end()) {
-        auto ghostPos = it->getGhost().getPosition();
-        float distance = std::sqrt(std::pow(playerPos.x - ghostPos.x, 2) +
-                                   std::pow(playerPos.y - ghostPos.y, 2));
+void Game::simulate() {
+    const sf::Time tickTime = GameSim::getTickTime();
+    sf::Time nextTick = timeSource->now() + tickTime;
 
-        // distance to consider a collision
-        if (distance < COLLISION_THRESHOLD) {
-            // Base score for destroying a ghost
-            score += 5;
-
-            // Bonus points based on ghost's life expectancy
-            float ghostAge = it->ghostLifeExpectancy();
-            // Subtract the ghost's age in seconds from 5 to a minimum of 1 ptn
-            int bonusPoints = std::max(5 - static_cast<int>(ghostAge), 1);
-            score += bonusPoints;
+    while (simRunning.load(std::memory_order_acquire)) {
+        sf::Time currentTime = timeSource->now();
+        if (currentTime < nextTick) {
+            sf::sleep(nextTick - currentTime);
+            continue;
+        }
+        nextTick = std::max(nextTick, currentTime - MAX_FRAME_TIME);
 
-            // Remove ghost
-            it = ghosts.erase(it);
-        } else {
-            ++it;
+        {
+            PROFILE_SCOPE("Game::simulate");
+            while (nextTick <= currentTime) {
+                std::uint8_t held = input.take(nextTick);
+                if (server) {
+                    server->update(held, nextTick);
+                    nextTick += tickTime;
+                    continue;
+                }
+                if (restartRequested.exchange(false, std::memory_order_relaxed)) {
+                    restart();
+                }
+                if (rewinding.load(std::memory_order_relaxed)) {
+                    // Stays on the oldest state once there's nothing further back
+                    if (rewind.pop(sim) == 0) {
+                        stopRecording();
+                    }
+                } else {
+                    sim.setInput(held);
+                    // Ticks after the end don't change anything, so there's nothing left to record
+                    if (!sim.isGameEnded()) {
+                        recorder.record(sim.getInput());
+                        rewind.push(sim);
+                    }
+                    sim.tick();
+                }
+                nextTick += tickTime;
+            }
+            // The frame drawn is interpolated from when the last tick was due
+            Snapshot& snapshot = snapshots.getBack();
+            if (server) {
+                server->capture(snapshot, nextTick - tickTime);
+            } else {
+                snapshot.capture(sim, nextTick - tickTime);
+            }
+            snapshot.inputSequence = input.getTaken();
+            snapshots.publish();
         }
     }
 }
 /**
- * Check if player is colliding with fruit
+ * Start a new game on the simulation thread, by restoring the saved start
+ * with a fresh seed instead of building a new simulation
+ */
+void Game::restart() {
+    PROFILE_SCOPE("Game::restart");
+    sim.restore(startState);
+    sim.reseed(Rng::randomSeed());
+    rewind.clear();
+    stopRecording();
+}
+/**
+ * A replay only follows one game played straight through, it ends at the first rewind or restart
  */
-void Game::checkFruitCollisions() {
-    auto playerPos = player.getPosition();
-    auto it = fruits.begin();
-    while (it != fruits.end()) {
-        auto fruitPos = it->getFruit().getPosition();
-        float distance = std::sqrt(std::pow(playerPos.x - fruitPos.x, 2) + std::pow(playerPos.y - fruitPos.y, 2));
+void Game::stopRecording() {
+    if (recorder.isOpen()) {
+        recorder.close();
+        std::cout << "Recording stopped, a replay can't follow a rewind or restart" << std::endl;
+    }
+}
 
-        if (distance < player.getRadius() + it->getFruit().getRadius()) {
-            // Give the speed boost, which ends 3 seconds from now
-            speedBoostEndTime = speedClock.getElapsedTime() + sf::seconds(3);
 
-            it = fruits.erase(it);
-        } else {
-            ++it;
-        }
-    }
+/**
+ * Center the camera on the player, stopping at the edges of the world
+ */
+void Game::followPlayer(const sf::Vector2f& position) {
+    const sf::Vector2f& world = sim.getWorldSize();
+    sf::Vector2f half = camera.getSize() / 2.0f;
+    camera.setCenter(std::min(std::max(position.x, half.x), std::max(world.x - half.x, half.x)),
+                     std::min(std::max(position.y, half.y), std::max(world.y - half.y, half.y)));
 }
 /**
- * Modify player speed and remove speed boost if needed
- * @return a float value representing player speed
+ * Whether a square of the given half size around the position overlaps the visible rectangle
  */
-float Game::pSpeed() {
-    if (speedClock.getElapsedTime() < speedBoostEndTime) {
-        return BOOSTED_P_SPEED;
-    }
-    return BASE_P_SPEED;
+bool Game::isVisible(const sf::FloatRect& visible, const sf::Vector2f& position, float halfSize) {
+    return position.x + halfSize >= visible.left && position.x - halfSize <= visible.left + visible.width &&
+           position.y + halfSize >= visible.top && position.y - halfSize <= visible.top + visible.height;
 }
 /**
- * Display visual speed boost indicator
- * @return 0 if successfully initialized, 1 otherwise
+ * Position between the last two ticks, alpha being how far into the next tick we are
  */
-int Game::displaySpeedText() {
-    if (!font.loadFromFile("resources/CyberpunkWaifus.ttf")) {
-        return 1;
-    }
-    speedBoostText.setFont(font);
-    speedBoostText.setCharacterSize(80);
-    speedBoostText.setFillColor(sf::Color::Green);
-    speedBoostText.setString("Speed Boost!");
-    // Top middle of the screen
-    sf::FloatRect textRect = speedBoostText.getLocalBounds();
-    speedBoostText.setOrigin(textRect.width / 2, textRect.height / 2);
-    speedBoostText.setPosition(getSceneWidth() / 2, 20);
-    return 0;
+sf::Vector2f Game::interpolate(const sf::Vector2f& previous, const sf::Vector2f& current, float alpha) {
+    return previous + (current - previous) * alpha;
 }
-
-
-
 /**
- * Render elements in the window
+ * Render the latest snapshot in the window, interpolated between its last two ticks
+ * by how far into the next tick we are
  */
 void Game::render() {
-    // General
-    window.draw(background);
+    PROFILE_SCOPE("Game::render");
+    snapshots.update();
+    const Snapshot& snapshot = snapshots.getFront();
+    float alpha = (timeSource->now() - snapshot.time).asSeconds() / GameSim::getTickTime().asSeconds();
+    // Past 1 the simulation is late, and the snapshot is as far as anything has gone
+    alpha = std::max(0.0f, std::min(alpha, 1.0f));
 
-    if (!gameEnded) {
-        window.draw(player);
-        for (auto& ghost : ghosts) {
-            ghost.updateMovement();
-            window.draw(ghost.getGhost());
+    // The world, through the camera, with only what's in view sent to the GPU
+    sf::Vector2f playerPosition = interpolate(snapshot.previousPlayerPosition, snapshot.playerPosition, alpha);
+    if (!snapshot.gameEnded) {
+        followPlayer(playerPosition);
+    }
+    window.setView(camera);
+    sf::FloatRect visible(camera.getCenter() - camera.getSize() / 2.0f, camera.getSize());
+    background.draw(window, visible);
+
+    if (!snapshot.gameEnded) {
+        for (const Snapshot::Sprite& other : snapshot.rivals) {
+            sf::Vector2f position = interpolate(other.previous, other.position, alpha);
+            if (isVisible(visible, position, GameSim::getPlayerRadius())) {
+                rival.setPosition(position);
+                window.draw(rival);
+            }
         }
-        for (const auto& fruit : fruits) {
-            window.draw(fruit.getFruit());
+        player.setPosition(playerPosition);
+        window.draw(player);
+        // Every ghost and fruit in view goes into one vertex array, drawn with a single call
+        PROFILE_SCOPE("Game::render entities");
+        entityBatch.begin();
+        for (const Snapshot::Sprite& ghost : snapshot.ghosts) {
+            sf::Vector2f position = interpolate(ghost.previous, ghost.position, alpha);
+            if (isVisible(visible, position, Ghost::getHitbox())) {
+                auto sprite = static_cast<ResourceManager::SpriteId>(ResourceManager::GHOST_BLUE + ghost.look);
+                entityBatch.add(position, Ghost::getHitbox(), resources.getSprite(sprite));
+            }
         }
-        // Text
-        scoreText.setString("Score: " + std::to_string(score) + " pts");
-        window.draw(scoreText);
-        // Check if we're within the speed boost period and draw the text if so
-        if (speedClock.getElapsedTime() < speedBoostEndTime) {
-            displaySpeedText();
-            window.draw(speedBoostText);
+        for (const Snapshot::Sprite& fruit : snapshot.fruits) {
+            if (isVisible(visible, fruit.position, Fruit::getHitbox())) {
+                auto sprite = static_cast<ResourceManager::SpriteId>(ResourceManager::FRUIT_CHERRY + fruit.look);
+                entityBatch.add(fruit.position, Fruit::getHitbox(), resources.getSprite(sprite));
+            }
         }
-        // Countdown text
-        clockRender();
-        window.draw(countdownText);
-    } else {
-        // If the game has ended, display the final score text
-        finalScoreRender();
-        window.draw(finalScoreText);
+        entityBatch.draw(window, resources.getAtlas());
     }
+    // Text stays on the screen rather than in the world
+    window.setView(window.getDefaultView());
+    // Text, only rebuilt when the values shown change
+    hud.update(snapshot);
+    hud.draw(window);
+#ifdef GAME_PROFILING
+    // Shows the previous frame, this one is still being timed
+    if (showProfiler) {
+        profilerOverlay.draw(window);
+    }
+#endif
 
-    window.display();
+    {
+        PROFILE_SCOPE("Game::render display");
+        window.display();
+    }
+    // Key changes the snapshot took are on screen now
+    input.presented(snapshot.inputSequence, timeSource->now());
+    // So is the server's answer to an input, once per server tick
+    if (server && snapshot.tick != lastServerTick && snapshot.ackedInputTime != sf::Time::Zero) {
+        serverLatencies[serverLatencyCount % serverLatencies.size()] = timeSource->now() - snapshot.ackedInputTime;
+        ++serverLatencyCount;
+    }
+    lastServerTick = snapshot.tick;
 }
 /**
- * Main function to deal with events, update the player and render the updated scene on the window.
+ * Main function, starts the simulation on its own thread and then deals with events
+ * and renders its snapshots on this one until the window is closed.
  */
 int Game::run() {
+    if (!resourcesLoaded) {
+        return 1;
+    }
+    startSimulation();
+
+    bool firstFrame = true;
     while (window.isOpen()) {
         processInput();
-        update();
-        checkObjNum();
-        checkCollisions();
-        checkFruitCollisions();
         render();
+        if (firstFrame) {
+            reportStartup();
+            firstFrame = false;
+        }
+
+        PROFILE_FRAME();
+#ifdef GAME_PROFILING
+        profilerOverlay.update(Profiler::get());
+#endif
     }
+    stopSimulation();
+    reportLatency();
     return 0;
 }
\ No newline at end of file
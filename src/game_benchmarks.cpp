@@ -0,0 +1,297 @@
+/*
+ * File: game_benchmarks.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Microbenchmarks of the game's hot paths, using Google Benchmark.
+ * Run with --benchmark_format=json (or build the benchmark_json target) to get
+ * results that can be compared across commits.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "batch_runner.h"
+#include "collision.h"
+#include "flow_field.h"
+#include "fruit.h"
+#include "game_sim.h"
+#include "ghost.h"
+#include "hud.h"
+#include "rng.h"
+#include "spatial_grid.h"
+#include "timer_wheel.h"
+
+/**
+ * Reaches into GameSim to fill it with far more entities than a game spawns.
+ * Entities are kept away from the player so a collision check finds them all
+ * but eats none, and every iteration measures the same world.
+ */
+class GameBenchmark {
+public:
+    static const float CLEAR_RADIUS;
+
+    static sf::Vector2f randPosition(Rng& rng) {
+        sf::Vector2f center(GameSim::getSceneWidth() / 2, GameSim::getSceneHeight() / 2);
+        while (true) {
+            sf::Vector2f position(rng.uniform(0.0f, GameSim::getSceneWidth()),
+                                  rng.uniform(0.0f, GameSim::getSceneHeight()));
+            sf::Vector2f offset = position - center;
+            if (offset.x * offset.x + offset.y * offset.y > CLEAR_RADIUS * CLEAR_RADIUS) {
+                return position;
+            }
+        }
+    }
+    static void fillGhosts(GameSim& sim, std::size_t count, Rng& rng) {
+        sim.ghosts.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            sf::Vector2f position = randPosition(rng);
+            std::size_t index = sim.ghosts.add(position, sim.getTime(), rng);
+            sim.ghostGrid.insert(static_cast<std::uint32_t>(index), position);
+        }
+        sim.hits.reserve(count);
+    }
+    static void fillFruits(GameSim& sim, std::size_t count, Rng& rng) {
+        sim.fruits.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            sf::Vector2f position = randPosition(rng);
+            std::uint32_t slot = sim.fruits.acquire();
+            sim.fruits[slot] = Fruit(position, rng);
+            sim.fruitGrid.insert(slot, position);
+        }
+        sim.hits.reserve(count);
+    }
+    static void checkCollisions(GameSim& sim) { sim.checkCollisions(); }
+    static void checkFruitCollisions(GameSim& sim) { sim.checkFruitCollisions(); }
+};
+const float GameBenchmark::CLEAR_RADIUS = 200.0f;
+
+/**
+ * Collision checks
+ */
+static void BM_CheckCollisions(benchmark::State& state) {
+    Rng rng(1);
+    GameSim sim(1);
+    GameBenchmark::fillGhosts(sim, static_cast<std::size_t>(state.range(0)), rng);
+    for (auto _ : state) {
+        GameBenchmark::checkCollisions(sim);
+    }
+}
+BENCHMARK(BM_CheckCollisions)->RangeMultiplier(10)->Range(10, 1000000);
+
+static void BM_CheckFruitCollisions(benchmark::State& state) {
+    Rng rng(1);
+    GameSim sim(1);
+    GameBenchmark::fillFruits(sim, static_cast<std::size_t>(state.range(0)), rng);
+    for (auto _ : state) {
+        GameBenchmark::checkFruitCollisions(sim);
+    }
+}
+BENCHMARK(BM_CheckFruitCollisions)->RangeMultiplier(10)->Range(10, 1000000);
+
+// The kernel alone over every entity, what the grid saves us from
+static void BM_FindHitsBruteForce(benchmark::State& state) {
+    Rng rng(1);
+    auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<float> xs(count);
+    std::vector<float> ys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vector2f position = GameBenchmark::randPosition(rng);
+        xs[i] = position.x;
+        ys[i] = position.y;
+    }
+    std::vector<std::uint32_t> hits(count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Collision::findHits(xs.data(), ys.data(), count, 960.0f, 640.0f, 80.0f,
+                                                     hits.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindHitsBruteForce)->RangeMultiplier(10)->Range(10, 1000000);
+
+/**
+ * Spawning, the argument being how many ghosts are already around. Crowded
+ * scenes reject more spots before finding a free one.
+ */
+static void BM_GhostRandSpawn(benchmark::State& state) {
+    Rng rng(1);
+    GameSim sim(1);
+    GameBenchmark::fillGhosts(sim, static_cast<std::size_t>(state.range(0)), rng);
+    sf::Vector2f player(GameSim::getSceneWidth() / 2, GameSim::getSceneHeight() / 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ghost::randSpawn(player, GameSim::getSceneSize(), rng, sim.getGhostGrid(),
+                                                  sim.getFruitGrid()));
+    }
+}
+BENCHMARK(BM_GhostRandSpawn)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_FruitRandSpawn(benchmark::State& state) {
+    Rng rng(1);
+    GameSim sim(1);
+    GameBenchmark::fillGhosts(sim, static_cast<std::size_t>(state.range(0)), rng);
+    sf::Vector2f player(GameSim::getSceneWidth() / 2, GameSim::getSceneHeight() / 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Fruit::randSpawn(player, GameSim::getSceneSize(), rng, sim.getGhostGrid(),
+                                                  sim.getFruitGrid()));
+    }
+}
+BENCHMARK(BM_FruitRandSpawn)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+/**
+ * Ghost movement, one tick of every ghost per iteration
+ */
+static void BM_GhostUpdateMovement(benchmark::State& state) {
+    Rng rng(1);
+    GhostStore ghosts;
+    auto count = static_cast<std::size_t>(state.range(0));
+    ghosts.reserve(count);
+    sf::Time now;
+    for (std::size_t i = 0; i < count; ++i) {
+        ghosts.turn(ghosts.add(GameBenchmark::randPosition(rng), now, rng));
+    }
+    for (auto _ : state) {
+        ghosts.updateMovement();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GhostUpdateMovement)->RangeMultiplier(10)->Range(10, 1000000);
+/**
+ * Ghost movement with every ghost chasing the player through the flow field,
+ * to compare against the random walk above
+ */
+static void BM_GhostChaseMovement(benchmark::State& state) {
+    Rng rng(1);
+    const GhostBehavior chase[Ghost::COLOR_COUNT] = {GHOST_CHASE, GHOST_CHASE, GHOST_CHASE, GHOST_CHASE};
+    GhostStore ghosts;
+    ghosts.setBehaviors(chase);
+    FlowField field(GameSim::getSceneWidth(), GameSim::getSceneHeight(), 80.0f);
+    field.update(GameSim::getSceneSize() / 2.0f);
+    auto count = static_cast<std::size_t>(state.range(0));
+    ghosts.reserve(count);
+    sf::Time now;
+    for (std::size_t i = 0; i < count; ++i) {
+        ghosts.add(GameBenchmark::randPosition(rng), now, rng);
+    }
+    for (auto _ : state) {
+        ghosts.updateMovement(&field);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GhostChaseMovement)->RangeMultiplier(10)->Range(10, 1000000);
+/**
+ * Flow field rebuild, paid on the ticks the player changes cell, by world scale
+ */
+static void BM_FlowFieldRebuild(benchmark::State& state) {
+    auto scale = static_cast<float>(state.range(0));
+    FlowField field(GameSim::getSceneWidth() * scale, GameSim::getSceneHeight() * scale, 80.0f);
+    sf::Vector2f targets[2] = {{40.0f, 40.0f}, {120.0f, 40.0f}};
+    std::size_t next = 0;
+    for (auto _ : state) {
+        field.update(targets[next ^= 1]);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(field.getCellCount()));
+}
+BENCHMARK(BM_FlowFieldRebuild)->Arg(1)->Arg(4)->Arg(16);
+/**
+ * Whole headless games as game_batch plays them, with every ghost wandering
+ * (0) or red ones chasing and blue ones fleeing (1), so a cost that only
+ * shows up over a full game, like rebuilding the field too often, shows up here
+ */
+static void BM_PlayGame(benchmark::State& state) {
+    SimConfig config;
+    if (state.range(0) != 0) {
+        config.ghostBehaviors[Ghost::RED] = GHOST_CHASE;
+        config.ghostBehaviors[Ghost::BLUE] = GHOST_FLEE;
+    }
+    std::size_t game = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BatchRunner::playGame(BatchRunner::gameSeed(7, game++), config, InputPolicy::CHASE));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PlayGame)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * Saving the whole game and restoring it, what one rewind step or a restart costs
+ */
+static void BM_GameSimSaveRestore(benchmark::State& state) {
+    Rng rng(1);
+    GameSim sim(1);
+    GameBenchmark::fillGhosts(sim, static_cast<std::size_t>(state.range(0)), rng);
+    SaveState save;
+    for (auto _ : state) {
+        sim.save(save);
+        sim.restore(save);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(save.size()));
+}
+BENCHMARK(BM_GameSimSaveRestore)->Arg(10)->Arg(1000)->Arg(100000);
+
+/**
+ * Timers, one tick with the given number of ghost turns pending over the next second
+ */
+static void BM_TimerWheelAdvance(benchmark::State& state) {
+    Rng rng(1);
+    TimerWheel timers;
+    auto count = static_cast<std::uint32_t>(state.range(0));
+    for (std::uint32_t i = 0; i < count; ++i) {
+        timers.schedule({static_cast<std::uint32_t>(rng.uniformInt(1, 120)), 0, i, 0});
+    }
+    std::uint32_t tick = 0;
+    for (auto _ : state) {
+        // every fired turn is rescheduled, so the wheel stays as full
+        ++tick;
+        timers.advance(tick, [&timers, &rng, tick](const TimerWheel::Timer& timer) {
+            timers.schedule({tick + static_cast<std::uint32_t>(rng.uniformInt(60, 108)), 0, timer.target, 0});
+        });
+    }
+}
+BENCHMARK(BM_TimerWheelAdvance)->RangeMultiplier(10)->Range(10, 100000);
+
+/**
+ * Entity construction
+ */
+static void BM_GhostStoreAdd(benchmark::State& state) {
+    Rng rng(1);
+    auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        GhostStore ghosts;
+        ghosts.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            ghosts.add(sf::Vector2f(500.0f, 500.0f), sf::Time::Zero, rng);
+        }
+        benchmark::DoNotOptimize(ghosts.getXs());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GhostStoreAdd)->Arg(10)->Arg(1000);
+
+static void BM_FruitConstruct(benchmark::State& state) {
+    Rng rng(1);
+    for (auto _ : state) {
+        Fruit fruit(sf::Vector2f(500.0f, 500.0f), rng);
+        benchmark::DoNotOptimize(fruit);
+    }
+}
+BENCHMARK(BM_FruitConstruct);
+
+/**
+ * HUD texts, a frame where the number changes and one where it doesn't
+ */
+static void BM_HudValueChanged(benchmark::State& state) {
+    HudValue value("Score: ", " pts");
+    int score = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.setValue(++score));
+    }
+}
+BENCHMARK(BM_HudValueChanged);
+
+static void BM_HudValueUnchanged(benchmark::State& state) {
+    HudValue value("Score: ", " pts");
+    value.setValue(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.setValue(42));
+    }
+}
+BENCHMARK(BM_HudValueUnchanged);
+
+BENCHMARK_MAIN();
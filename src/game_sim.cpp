@@ -0,0 +1,474 @@
+/*
+ * File: game_sim.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: GameSim class holding the PacMan game state and rules, with no
+ * window or rendering involved so it can run headless
+ */
+
+#include "game_sim.h"
+#include "job_system.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+const int GameSim::TICK_RATE = 120;
+const float GameSim::SCENE_WIDTH = 1920.0f;
+const float GameSim::SCENE_HEIGHT = 1280.0f;
+const float GameSim::RADIUS = 40.0f;
+// 1/sqrt(2), so both axes together make one speed's worth of movement
+const float GameSim::DIAGONAL_SCALE = 0.70710678f;
+const float GameSim::COLLISION_THRESHOLD = 80;
+// Grid cells are one ghost wide, so a collision query only looks at the cells around the player
+const float GameSim::GRID_CELL_SIZE = 80.0f;
+// Ghosts per job when updating them on the thread pool
+const std::size_t GameSim::GHOST_CHUNK_SIZE = 4096;
+
+/**
+ * GameSim constructor, every random decision in the game comes from the seed
+ */
+GameSim::GameSim(std::uint64_t seed, const SimConfig& config)
+        : seed(seed), config(config),
+          worldSize(SCENE_WIDTH * static_cast<float>(config.worldScale),
+                    SCENE_HEIGHT * static_cast<float>(config.worldScale)),
+          rng(seed), jobs(nullptr), tickCount(0), ghostSpawnWaiting(false), fruitSpawnWaiting(false),
+          ghostGrid(worldSize.x, worldSize.y, GRID_CELL_SIZE), fruitGrid(worldSize.x, worldSize.y, GRID_CELL_SIZE),
+          playerField(worldSize.x, worldSize.y, GRID_CELL_SIZE),
+          fieldFollowed(std::any_of(std::begin(config.ghostBehaviors), std::end(config.ghostBehaviors),
+                                    [](GhostBehavior behavior) { return behavior != GHOST_WANDER; })),
+          gameEnded(false) {
+    // Players start spread across the middle row of the world, a lone player in its center
+    auto playerCount = static_cast<std::size_t>(std::max(config.players, 1));
+    for (std::size_t i = 0; i < playerCount; ++i) {
+        playerPositions.emplace_back(worldSize.x * static_cast<float>(i + 1) / static_cast<float>(playerCount + 1),
+                                     worldSize.y / 2.0f);
+        players.push_back(Player{INPUT_NONE, false, 0, 0, 0, 0});
+    }
+    previousPlayerPositions = playerPositions;
+
+    // Everything a game can hold is allocated here, spawning and despawning only reuse it
+    ghosts.setBounds(worldSize);
+    ghosts.setBehaviors(config.ghostBehaviors);
+    updatePlayerField();
+    ghosts.reserve(config.maxGhosts);
+    fruits.reserve(config.maxFruits);
+    ghostGrid.reserve(config.maxGhosts);
+    fruitGrid.reserve(config.maxFruits);
+    // a turn per ghost, both spawns, the game over and a few overlapping boosts per player
+    timers.reserve(config.maxGhosts + config.maxFruits + 8 * playerCount);
+    hits.reserve(std::max(config.maxGhosts, config.maxFruits));
+    nextSpawnTime = randSpawnDelay(0);
+
+    schedule(GAME_OVER, ticksFor(config.totalTime.asSeconds()));
+    schedule(GHOST_SPAWN, ticksFor(nextSpawnTime));
+    // The first fruit comes right away
+    schedule(FRUIT_SPAWN, ticksFor(nextFruitSpawnTime));
+}
+
+/**
+ * Advance the simulation by one fixed step of getTickTime()
+ */
+void GameSim::tick() {
+    PROFILE_SCOPE("GameSim::tick");
+    ++tickCount;
+    runTimers();
+    update();
+    updatePlayerField();
+    updateGhosts();
+    checkCollisions();
+    checkFruitCollisions();
+}
+/**
+ * Run as many ticks as fit in the given amount of game time
+ */
+void GameSim::advance(sf::Time duration) {
+    std::int64_t ticks = duration.asMicroseconds() * TICK_RATE / 1000000;
+    for (std::int64_t i = 0; i < ticks; ++i) {
+        tick();
+    }
+}
+
+
+/**
+ * Write the whole game state into a flat save state, replacing what it held.
+ * Grids and the flow field aren't saved, they only depend on positions and
+ * are rebuilt on restore.
+ */
+void GameSim::save(SaveState& state) const {
+    PROFILE_SCOPE("GameSim::save");
+    state.clear();
+    state.write(seed);
+    state.write(rng);
+    state.write(tickCount);
+    state.writeVector(playerPositions);
+    state.writeVector(previousPlayerPositions);
+    state.writeVector(players);
+    state.write(ghostSpawnWaiting);
+    state.write(fruitSpawnWaiting);
+    state.write(nextSpawnTime);
+    state.write(nextFruitSpawnTime);
+    state.write(gameEnded);
+    timers.save(state);
+    ghosts.save(state);
+    fruits.save(state);
+}
+/**
+ * Go back to a saved state, reusing every buffer the game already has
+ * @return 0 if restored, 1 if the state is empty or doesn't hold a whole game
+ */
+int GameSim::restore(const SaveState& state) {
+    PROFILE_SCOPE("GameSim::restore");
+    if (state.empty()) {
+        return 1;
+    }
+    std::size_t offset = 0;
+    state.read(offset, seed);
+    state.read(offset, rng);
+    state.read(offset, tickCount);
+    state.readVector(offset, playerPositions);
+    state.readVector(offset, previousPlayerPositions);
+    state.readVector(offset, players);
+    state.read(offset, ghostSpawnWaiting);
+    state.read(offset, fruitSpawnWaiting);
+    state.read(offset, nextSpawnTime);
+    state.read(offset, nextFruitSpawnTime);
+    state.read(offset, gameEnded);
+    timers.restore(state, offset);
+    ghosts.restore(state, offset);
+    fruits.restore(state, offset);
+
+    // Collisions sort what the grids find, so the order entities go back in doesn't matter
+    ghostGrid.clear();
+    for (std::size_t i = 0; i < ghosts.size(); ++i) {
+        ghostGrid.insert(static_cast<std::uint32_t>(i), ghosts.getPosition(i));
+    }
+    fruitGrid.clear();
+    for (auto it = fruits.begin(); it != fruits.end(); ++it) {
+        fruitGrid.insert(it.getSlot(), (*it).getPosition());
+    }
+    updatePlayerField();
+    return offset == state.size() ? 0 : 1;
+}
+/**
+ * Size of a save of the current game, grown by the ghosts it can still spawn.
+ * Everything else a save holds has a fixed size for a given config.
+ */
+std::size_t GameSim::getMaxSaveSize() const {
+    SaveState state;
+    save(state);
+    std::size_t moreGhosts = static_cast<std::size_t>(config.maxGhosts) - std::min(ghosts.size(),
+            static_cast<std::size_t>(config.maxGhosts));
+    return state.size() + moreGhosts * GhostStore::getSavedBytesPerGhost();
+}
+/**
+ * Draw every random decision from now on from the given seed. Ghosts already
+ * spawned keep their own streams.
+ */
+void GameSim::reseed(std::uint64_t newSeed) {
+    seed = newSeed;
+    rng = Rng(newSeed);
+}
+
+
+/**
+ * Time remaining before the game ends
+ * @return the remaining time, never below zero
+ */
+sf::Time GameSim::getTimeLeft() const {
+    if (gameEnded) {
+        return sf::seconds(0);
+    }
+    sf::Time timeLeft = config.totalTime - getTime();
+    return timeLeft <= sf::seconds(0) ? sf::seconds(0) : timeLeft;
+}
+
+
+/**
+ * Whole ticks in the given number of seconds, at least one so a timer never
+ * lands on the tick that schedules it
+ */
+std::uint32_t GameSim::ticksFor(float seconds) {
+    auto ticks = static_cast<std::uint32_t>(std::ceil(seconds * static_cast<float>(TICK_RATE)));
+    return std::max<std::uint32_t>(ticks, 1);
+}
+/**
+ * Schedule a timer the given number of ticks from now
+ */
+void GameSim::schedule(TimerType type, std::uint32_t ticks, std::uint32_t target, std::uint32_t generation) {
+    timers.schedule(TimerWheel::Timer{tickCount + ticks, type, target, generation});
+}
+/**
+ * Fire every timer due this tick, the cost only depends on how many there are
+ */
+void GameSim::runTimers() {
+    PROFILE_SCOPE("GameSim::runTimers");
+    timers.advance(tickCount, [this](const TimerWheel::Timer& timer) { fireTimer(timer); });
+}
+/**
+ * Do what a timer was set for
+ */
+void GameSim::fireTimer(const TimerWheel::Timer& timer) {
+    // The game may have ended on a timer of this same tick
+    if (gameEnded) {
+        return;
+    }
+    switch (timer.type) {
+        case GAME_OVER:
+            endGame();
+            break;
+        case GHOST_SPAWN:
+            if (ghosts.size() < static_cast<std::size_t>(config.maxGhosts)) {
+                spawnGhost();
+            } else {
+                ghostSpawnWaiting = true;
+            }
+            break;
+        case FRUIT_SPAWN:
+            if (fruits.size() < static_cast<std::size_t>(config.maxFruits)) {
+                spawnFruit();
+            } else {
+                fruitSpawnWaiting = true;
+            }
+            break;
+        case BOOST_END:
+            // An older boost's timer, a later fruit pushed the end back
+            if (timer.generation == players[timer.target].boostGeneration) {
+                players[timer.target].speedBoosted = false;
+            }
+            break;
+        case GHOST_TURN: {
+            std::size_t index;
+            if (ghosts.findIndex(timer.target, timer.generation, index)) {
+                scheduleTurn(index);
+            }
+            break;
+        }
+    }
+}
+/**
+ * Time is up, clear ghosts, fruits and every pending timer
+ */
+void GameSim::endGame() {
+    gameEnded = true;
+    for (Player& player : players) {
+        player.speedBoosted = false;
+    }
+    ghosts.clear();
+    fruits.clear();
+    ghostGrid.clear();
+    fruitGrid.clear();
+    timers.clear();
+}
+
+
+/**
+ * Function to update the position of every player
+ */
+void GameSim::update() {
+    PROFILE_SCOPE("GameSim::update");
+    previousPlayerPositions = playerPositions;
+
+    // Check if game is going on
+    if (gameEnded) {
+        return;
+    }
+
+    // Movement
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        if (players[i].speedBoosted) {
+            ++players[i].boostedTicks;
+        }
+        playerPositions[i] = movePlayer(playerPositions[i], players[i].input, getPlayerSpeed(i), worldSize);
+    }
+}
+/**
+ * Where a player at the given position ends up after one tick of holding the given input
+ */
+sf::Vector2f GameSim::movePlayer(const sf::Vector2f& position, std::uint8_t input, float speed,
+                                 const sf::Vector2f& world) {
+    sf::Vector2f moved = position;
+    // Every direction held counts, opposite ones cancel out
+    float dirX = static_cast<float>(((input & INPUT_RIGHT) != 0) - ((input & INPUT_LEFT) != 0));
+    float dirY = static_cast<float>(((input & INPUT_DOWN) != 0) - ((input & INPUT_UP) != 0));
+    // Diagonals are as fast as straight lines
+    if (dirX != 0 && dirY != 0) {
+        speed *= DIAGONAL_SCALE;
+    }
+    if ((dirY < 0 && moved.y > RADIUS) || (dirY > 0 && moved.y < world.y - RADIUS)) {
+        moved.y += dirY * speed;
+    }
+    if ((dirX < 0 && moved.x > RADIUS) || (dirX > 0 && moved.x < world.x - RADIUS)) {
+        moved.x += dirX * speed;
+    }
+    return moved;
+}
+
+
+/**
+ * Random spawn delay for ghost creation
+ */
+float GameSim::randSpawnDelay(int type) {
+    if (type == 0) { // For Ghosts, shorter spawn delay
+        return rng.uniform(config.ghostSpawnDelayMin, config.ghostSpawnDelayMax);
+    } else { // For Fruits, longer spawn delay
+        return rng.uniform(config.fruitSpawnDelayMin, config.fruitSpawnDelayMax);
+    }
+}
+/**
+ * Add a ghost away from the player and set up its next spawn and first turn
+ */
+void GameSim::spawnGhost() {
+    sf::Vector2f spawnPosition = Ghost::randSpawn(playerPositions.data(), playerPositions.size(), worldSize, rng,
+                                                  ghostGrid, fruitGrid);
+    std::size_t index = ghosts.add(spawnPosition, getTime(), rng);
+    ghostGrid.insert(static_cast<std::uint32_t>(index), spawnPosition);
+    // Chasing and fleeing ghosts follow the field instead of turning
+    if (ghosts.getBehavior(index) == GHOST_WANDER) {
+        scheduleTurn(index);
+    }
+    nextSpawnTime = randSpawnDelay(0); // Set next spawn delay
+    schedule(GHOST_SPAWN, ticksFor(nextSpawnTime));
+}
+/**
+ * Add a fruit the same way
+ */
+void GameSim::spawnFruit() {
+    sf::Vector2f spawnPosition = Fruit::randSpawn(playerPositions.data(), playerPositions.size(), worldSize, rng,
+                                                  ghostGrid, fruitGrid);
+    std::uint32_t slot = fruits.acquire();
+    fruits[slot] = Fruit(spawnPosition, rng);
+    fruitGrid.insert(slot, spawnPosition);
+    nextFruitSpawnTime = randSpawnDelay(1); // Using existing method
+    schedule(FRUIT_SPAWN, ticksFor(nextFruitSpawnTime));
+}
+/**
+ * Turn a ghost now and schedule its next turn
+ */
+void GameSim::scheduleTurn(std::size_t index) {
+    float delay = ghosts.turn(index);
+    std::uint32_t id = ghosts.getId(index);
+    schedule(GHOST_TURN, ticksFor(delay), id, ghosts.getGeneration(id));
+}
+/**
+ * Point the ghosts' flow field at the nearest player, once per tick for every
+ * ghost. It only does any work on the ticks a player changes cell, and none
+ * at all in games where every ghost wanders.
+ */
+void GameSim::updatePlayerField() {
+    if (!fieldFollowed) {
+        return;
+    }
+    PROFILE_SCOPE("GameSim::updatePlayerField");
+    playerField.update(playerPositions.data(), playerPositions.size());
+}
+/**
+ * Move every ghost one step, wandering ones turn on their own timers and the
+ * others follow the player's field. Moving only touches each ghost's own
+ * slots and reads the field, so the result is the same however the ghosts
+ * are split between threads.
+ */
+void GameSim::updateGhosts() {
+    PROFILE_SCOPE("GameSim::updateGhosts");
+    if (jobs != nullptr && ghosts.size() > GHOST_CHUNK_SIZE) {
+        jobs->parallelFor(ghosts.size(), GHOST_CHUNK_SIZE, [this](std::size_t begin, std::size_t end) {
+            PROFILE_SCOPE("GhostStore::updateMovement chunk");
+            ghosts.updateMovement(begin, end, &playerField);
+        });
+    } else {
+        ghosts.updateMovement(&playerField);
+    }
+    // The grid isn't thread safe, but most ghosts stay in their cell and this is just a compare
+    PROFILE_SCOPE("SpatialGrid::move ghosts");
+    for (std::size_t i = 0; i < ghosts.size(); ++i) {
+        ghostGrid.move(static_cast<std::uint32_t>(i), ghosts.getPosition(i));
+    }
+}
+/**
+ * Remove a ghost from the store and the grid, the last ghost takes its index
+ */
+void GameSim::removeGhost(std::size_t index) {
+    auto last = static_cast<std::uint32_t>(ghosts.size() - 1);
+    ghostGrid.remove(static_cast<std::uint32_t>(index));
+    if (index != last) {
+        ghostGrid.rename(last, static_cast<std::uint32_t>(index));
+    }
+    ghosts.remove(index);
+    if (ghostSpawnWaiting) {
+        ghostSpawnWaiting = false;
+        schedule(GHOST_SPAWN, 1);
+    }
+}
+/**
+ * Give a fruit's slot back to the pool, no other fruit moves
+ */
+void GameSim::removeFruit(std::uint32_t slot) {
+    fruitGrid.remove(slot);
+    fruits.release(slot);
+    if (fruitSpawnWaiting) {
+        fruitSpawnWaiting = false;
+        schedule(FRUIT_SPAWN, 1);
+    }
+}
+
+
+/**
+ * Check if players are colliding with ghosts, a ghost two players reach on
+ * the same tick goes to the first one
+ */
+void GameSim::checkCollisions() {
+    PROFILE_SCOPE("GameSim::checkCollisions");
+    for (std::size_t p = 0; p < players.size(); ++p) {
+        Player& player = players[p];
+        // distance to consider a collision, only the grid cells around the player are looked at
+        ghostGrid.query(playerPositions[p], COLLISION_THRESHOLD, hits);
+        std::sort(hits.begin(), hits.end());
+
+        // Go from the back so removing a ghost never moves another hit ghost
+        for (std::size_t h = hits.size(); h-- > 0;) {
+            std::size_t i = hits[h];
+
+            // Base score for destroying a ghost
+            player.score += 5;
+            ++player.ghostsEaten;
+
+            // Bonus points based on ghost's life expectancy
+            float ghostAge = ghosts.ghostLifeExpectancy(i, getTime());
+            // Subtract the ghost's age in seconds from 5 to a minimum of 1 ptn
+            int bonusPoints = std::max(5 - static_cast<int>(ghostAge), 1);
+            player.score += bonusPoints;
+
+            // Remove ghost
+            removeGhost(i);
+        }
+    }
+}
+/**
+ * Check if players are colliding with fruits
+ */
+void GameSim::checkFruitCollisions() {
+    PROFILE_SCOPE("GameSim::checkFruitCollisions");
+    for (std::size_t p = 0; p < players.size(); ++p) {
+        fruitGrid.query(playerPositions[p], RADIUS + Fruit::getHitbox(), hits);
+        std::sort(hits.begin(), hits.end());
+
+        for (std::size_t h = hits.size(); h-- > 0;) {
+            // Give the speed boost, which ends boostDuration from now
+            players[p].speedBoosted = true;
+            schedule(BOOST_END, ticksFor(config.boostDuration.asSeconds()), static_cast<std::uint32_t>(p),
+                     ++players[p].boostGeneration);
+
+            removeFruit(hits[h]);
+        }
+    }
+}
+/**
+ * Player speed, boosted while a fruit's boost lasts
+ * @return a float value representing player speed
+ */
+float GameSim::getPlayerSpeed(std::size_t player) const {
+    if (isSpeedBoosted(player)) {
+        return config.boostedPlayerSpeed;
+    }
+    return config.basePlayerSpeed;
+}
@@ -6,9 +6,27 @@
  */
 
 #include <gtest/gtest.h>
-#include "game.h"
+#include <algorithm>
+#include "alloc_tracker.h"
+#include "asset_bundle.h"
+#include "batch_runner.h"
+#include "game_sim.h"
 #include "ghost.h"
 #include "fruit.h"
+#include "collision.h"
+#include "input_queue.h"
+#include "job_system.h"
+#include "net_client.h"
+#include "net_protocol.h"
+#include "net_server.h"
+#include "pool.h"
+#include "profiler.h"
+#include "replay.h"
+#include "rewind_buffer.h"
+#include "snapshot.h"
+#include "triple_buffer.h"
+#include <cstdio>
+#include <thread>
 
 /**
  * GameTest class which creates a simulated environment to test the behaviour
@@ -18,25 +36,34 @@
  */
 class GameTest : public ::testing::Test {
 protected:
-    Game game;
-    std::unique_ptr<Ghost> ghost;
+    GameSim game;
     std::unique_ptr<Fruit> fruit;
+    Rng rng;
 
 protected:
     void SetUp() override {
-        fruit = std::make_unique<Fruit>(sf::Vector2f(100.f, 100.f));
+        fruit = std::make_unique<Fruit>(sf::Vector2f(100.f, 100.f), rng);
     }
 
-    void simulateTime(sf::Clock clock, float seconds) {
-        // We create an initial time point
-        sf::Time elapsedTime = clock.restart();
-        while (elapsedTime.asSeconds() < seconds) {
-            // Update the ghost's movement based on the elapsed time
-            game.checkObjNum();
+    void simulateTime(float seconds) {
+        // Game time is virtual, so this runs as fast as the ticks can go
+        game.advance(sf::seconds(seconds));
+    }
 
-            // Add "game ticks"
-            sf::Time frameTime = clock.restart();
-            elapsedTime += frameTime;
+    // Private state of the game, reachable since GameTest is a friend
+    void moveGhost(std::size_t index, const sf::Vector2f& position) {
+        game.ghosts.setPosition(index, position);
+        game.ghostGrid.move(static_cast<std::uint32_t>(index), position);
+    }
+    void checkCollisions() { game.checkCollisions(); }
+    // what eating a fruit does, with the boost lasting the given ticks
+    void giveBoost(std::uint32_t ticks) {
+        game.players[0].speedBoosted = true;
+        game.schedule(GameSim::BOOST_END, ticks, 0, ++game.players[0].boostGeneration);
+    }
+    void ticks(int count) {
+        for (int i = 0; i < count; ++i) {
+            game.tick();
         }
     }
 };
@@ -46,15 +73,453 @@ protected:
 // Test to validate fruit spawning
 TEST_F(GameTest, EntitiesSpawnWithinLimits) {
     // Simulate time to trigger spawning
-    simulateTime(game.getGhostSpawnClock(), game.getNextSpawnTime() + 0.1f);
+    simulateTime(game.getNextSpawnTime() + 0.1f);
 
     // Check if a ghost is spawned
-    EXPECT_LE(game.getGhosts().size(), Game::getMaxGhosts());
+    EXPECT_LE(game.getGhosts().size(), static_cast<std::size_t>(game.getMaxGhosts()));
 
     // Repeat for fruits
-    simulateTime(game.getFruitSpawnClock(), game.getNextFruitSpawnTime() + 0.1f);
+    simulateTime(game.getNextFruitSpawnTime() + 0.1f);
+
+    EXPECT_LE(game.getFruits().size(), static_cast<std::size_t>(game.getMaxFruits()));
+}
+
+/**
+ * Headless simulation tests
+ */
+// The simulation steps the player from its input without any window around
+TEST_F(GameTest, PlayerMovesWithInput) {
+    sf::Vector2f start = game.getPlayerPosition();
+
+    game.setInput(INPUT_RIGHT);
+    game.tick();
+    float straight = game.getPlayerPosition().x - start.x;
+    EXPECT_GT(straight, 0.0f);
+    EXPECT_EQ(game.getPlayerPosition().y, start.y);
+
+    // Every direction held counts, diagonals at the same speed as straight lines
+    sf::Vector2f before = game.getPlayerPosition();
+    game.setInput(INPUT_UP | INPUT_RIGHT);
+    game.tick();
+    sf::Vector2f moved = game.getPlayerPosition() - before;
+    EXPECT_LT(moved.y, 0.0f);
+    EXPECT_GT(moved.x, 0.0f);
+    EXPECT_NEAR(std::sqrt(moved.x * moved.x + moved.y * moved.y), straight, 1e-3f);
+
+    // Opposite directions cancel out
+    before = game.getPlayerPosition();
+    game.setInput(INPUT_LEFT | INPUT_RIGHT);
+    game.tick();
+    EXPECT_EQ(game.getPlayerPosition(), before);
+}
+// A whole game plays out in virtual time without waiting for the real clock
+TEST_F(GameTest, GameEndsAfterTotalTime) {
+    simulateTime(22.9f);
+    EXPECT_FALSE(game.isGameEnded());
+
+    simulateTime(0.2f);
+    EXPECT_TRUE(game.isGameEnded());
+    EXPECT_TRUE(game.getGhosts().empty());
+    EXPECT_EQ(game.getTimeLeft(), sf::seconds(0));
+}
+// Two games from the same seed and input play out identically
+TEST_F(GameTest, SameSeedSameGame) {
+    GameSim first(1234);
+    GameSim second(1234);
+    for (int i = 0; i < 1200; ++i) {
+        std::uint8_t input = (i / 100) % 2 == 0 ? INPUT_RIGHT : INPUT_DOWN;
+        first.setInput(input);
+        second.setInput(input);
+        first.tick();
+        second.tick();
+    }
+    const GhostStore& firstGhosts = first.getGhosts();
+    const GhostStore& secondGhosts = second.getGhosts();
+    ASSERT_EQ(firstGhosts.size(), secondGhosts.size());
+    for (size_t i = 0; i < firstGhosts.size(); ++i) {
+        EXPECT_EQ(firstGhosts.getPosition(i), secondGhosts.getPosition(i));
+        EXPECT_EQ(firstGhosts.getColor(i), secondGhosts.getColor(i));
+    }
+    EXPECT_EQ(first.getScore(), second.getScore());
+    EXPECT_EQ(first.getPlayerPosition(), second.getPlayerPosition());
+}
+
+
+// Eating a ghost scores the base 5 points plus the freshness bonus
+TEST_F(GameTest, EatingGhostScores) {
+    simulateTime(game.getNextSpawnTime() + 0.1f);
+    ASSERT_FALSE(game.getGhosts().empty());
+    game.setInput(INPUT_NONE);
+    int scoreBefore = game.getScore();
+    std::size_t ghostsBefore = game.getGhosts().size();
+
+    moveGhost(0, game.getPlayerPosition());
+    checkCollisions();
+
+    EXPECT_EQ(game.getGhosts().size(), ghostsBefore - 1);
+    EXPECT_EQ(game.getScore(), scoreBefore + 5 + 5);
+}
+
+
+/**
+ * Random generator tests
+ */
+// Seeds and split streams are the same on every compiler, or replays and batch seeds wouldn't carry over
+TEST(RngTest, SplitIsTheSameEverywhere) {
+    Rng rng(42);
+    EXPECT_EQ(rng.next64(), 2429506107436103504ULL);
+    Rng parent(42);
+    Rng child = parent.split();
+    EXPECT_EQ(child.next(), 1607249302u);
+}
+
+/**
+ * Collision kernel tests
+ */
+// Every vector backend the CPU supports finds exactly what the scalar loop finds
+TEST(CollisionTest, BackendsAgreeWithScalar) {
+    Rng rng(7);
+    const std::size_t count = 1003; // not a multiple of the vector width
+    std::vector<float> xs(count);
+    std::vector<float> ys(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        xs[i] = rng.uniform(0.0f, 1920.0f);
+        ys[i] = rng.uniform(0.0f, 1280.0f);
+    }
+    std::vector<std::uint32_t> expected(count);
+    std::size_t expectedCount = Collision::findHits(Collision::SCALAR, xs.data(), ys.data(), count,
+                                                    960.0f, 640.0f, 300.0f, expected.data());
+    ASSERT_GT(expectedCount, 0u);
+
+    for (Collision::Backend backend : {Collision::SSE, Collision::AVX2}) {
+        if (!Collision::isSupported(backend)) {
+            continue;
+        }
+        std::vector<std::uint32_t> found(count);
+        std::size_t foundCount = Collision::findHits(backend, xs.data(), ys.data(), count,
+                                                     960.0f, 640.0f, 300.0f, found.data());
+        ASSERT_EQ(foundCount, expectedCount);
+        for (std::size_t i = 0; i < foundCount; ++i) {
+            EXPECT_EQ(found[i], expected[i]);
+        }
+    }
+}
+
+
+/**
+ * Spatial grid tests
+ */
+// Radius queries find the same entities as checking all of them, through moves, removals and renames
+TEST(SpatialGridTest, QueryMatchesBruteForce) {
+    const float width = GameSim::getSceneWidth();
+    const float height = GameSim::getSceneHeight();
+    SpatialGrid grid(width, height, 80.0f);
+    Rng rng(3);
+    std::vector<sf::Vector2f> positions;
+    for (std::uint32_t id = 0; id < 500; ++id) {
+        positions.emplace_back(rng.uniform(0.0f, width), rng.uniform(0.0f, height));
+        grid.insert(id, positions.back());
+    }
+    for (std::uint32_t id = 0; id < positions.size(); ++id) {
+        positions[id] += sf::Vector2f(rng.uniform(-100.0f, 100.0f), rng.uniform(-100.0f, 100.0f));
+        grid.move(id, positions[id]);
+    }
+    // Swap-and-pop the first 100 entities like the game does
+    for (int i = 0; i < 100; ++i) {
+        auto last = static_cast<std::uint32_t>(positions.size() - 1);
+        grid.remove(0);
+        grid.rename(last, 0);
+        positions[0] = positions[last];
+        positions.pop_back();
+    }
+
+    std::vector<std::uint32_t> found;
+    for (int q = 0; q < 50; ++q) {
+        sf::Vector2f center(rng.uniform(0.0f, width), rng.uniform(0.0f, height));
+        grid.query(center, 120.0f, found);
+        std::sort(found.begin(), found.end());
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t id = 0; id < positions.size(); ++id) {
+            sf::Vector2f d = positions[id] - center;
+            if (d.x * d.x + d.y * d.y < 120.0f * 120.0f) {
+                expected.push_back(id);
+            }
+        }
+        EXPECT_EQ(found, expected);
+        EXPECT_EQ(grid.anyWithin(center, 120.0f), !expected.empty());
+    }
+}
+// Ghosts don't spawn on top of ghosts or fruits when there is room elsewhere
+TEST(SpatialGridTest, SpawnKeepsClearance) {
+    SpatialGrid ghostGrid(GameSim::getSceneWidth(), GameSim::getSceneHeight(), 80.0f);
+    SpatialGrid fruitGrid(GameSim::getSceneWidth(), GameSim::getSceneHeight(), 80.0f);
+    Rng rng(11);
+    sf::Vector2f player(960.f, 640.f);
+    std::vector<sf::Vector2f> spawned;
+    for (std::uint32_t id = 0; id < 100; ++id) {
+        sf::Vector2f position = Ghost::randSpawn(player, GameSim::getSceneSize(), rng, ghostGrid, fruitGrid);
+        for (const auto& other : spawned) {
+            sf::Vector2f d = position - other;
+            EXPECT_GE(std::sqrt(d.x * d.x + d.y * d.y), 2 * Ghost::getHitbox());
+        }
+        spawned.push_back(position);
+        ghostGrid.insert(id, position);
+    }
+}
+
+
+/**
+ * Replay tests
+ */
+// A recorded session simulates again to the exact same game, from a small file
+TEST(ReplayTest, ReplayReproducesSession) {
+    const std::string path = "replay_test.rep";
+    SimConfig config;
+    config.worldScale = 2;
+    GameSim original(1234, config);
+    InputPolicy player(InputPolicy::RANDOM, 1234);
+    {
+        ReplayWriter writer;
+        ASSERT_EQ(writer.open(path, original.getSeed(), config.worldScale), 0);
+        while (!original.isGameEnded()) {
+            original.setInput(player.next(original));
+            writer.record(original.getInput());
+            original.tick();
+        }
+    }
+
+    ReplayReader reader;
+    ASSERT_EQ(reader.open(path), 0);
+    ASSERT_EQ(reader.getWorldScale(), 2);
+    config.worldScale = reader.getWorldScale();
+    GameSim replayed(reader.getSeed(), config);
+    std::uint8_t input;
+    while (reader.next(input)) {
+        replayed.setInput(input);
+        replayed.tick();
+    }
+    EXPECT_EQ(replayed.getTickCount(), original.getTickCount());
+    EXPECT_EQ(replayed.getScore(), original.getScore());
+    EXPECT_EQ(replayed.getGhostsEaten(), original.getGhostsEaten());
+    EXPECT_EQ(replayed.getPlayerPosition(), original.getPlayerPosition());
+    EXPECT_TRUE(replayed.isGameEnded());
+
+    // Direction changes about once a second here, so a few bytes per second of play
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    EXPECT_LT(file.tellg(), static_cast<std::streamoff>(14 + 4 * original.getTime().asSeconds()));
+    file.close();
+    std::remove(path.c_str());
+}
+// Files that aren't replays are turned down
+TEST(ReplayTest, RejectsOtherFiles) {
+    const std::string path = "not_a_replay.rep";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "PMRQ not a replay";
+    }
+    ReplayReader reader;
+    EXPECT_EQ(reader.open(path), 1);
+    std::remove(path.c_str());
+}
+
+
+/**
+ * Profiler tests
+ */
+// Zones of a frame are tallied by name when the frame ends
+TEST(ProfilerTest, FrameTalliesZones) {
+    Profiler profiler;
+    profiler.record("tick", 0, 1000);
+    profiler.record("tick", 2000, 4000);
+    profiler.record("render", 4000, 9000);
+    profiler.endFrame();
+
+    const std::vector<Profiler::ZoneStats>& zones = profiler.getFrameZones();
+    ASSERT_EQ(zones.size(), 2u);
+    EXPECT_STREQ(zones[0].name, "tick");
+    EXPECT_EQ(zones[0].total, 3000);
+    EXPECT_EQ(zones[0].calls, 2u);
+    EXPECT_EQ(zones[1].total, 5000);
+    EXPECT_EQ(profiler.getFrameCount(), 1u);
+
+    // The next frame starts from nothing
+    profiler.endFrame();
+    EXPECT_TRUE(profiler.getFrameZones().empty());
+}
+// A full ring keeps the newest zones and the trace only holds what's kept
+TEST(ProfilerTest, RingOverwritesOldestZones) {
+    Profiler profiler;
+    for (std::size_t i = 0; i < Profiler::EVENT_CAPACITY + 10; ++i) {
+        profiler.record("zone", 0, 1);
+    }
+    EXPECT_EQ(profiler.getEventCount(), Profiler::EVENT_CAPACITY + 10);
+    profiler.endFrame();
+    ASSERT_EQ(profiler.getFrameZones().size(), 1u);
+    EXPECT_EQ(profiler.getFrameZones()[0].calls, Profiler::EVENT_CAPACITY);
+
+    const std::string path = "profiler_test.json";
+    ASSERT_EQ(profiler.dumpChromeTrace(path), 0);
+    std::ifstream file(path);
+    std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    EXPECT_EQ(trace.compare(0, 15, "{\"displayTimeUn"), 0);
+    std::size_t events = 0;
+    for (std::size_t at = trace.find("\"ph\":\"X\""); at != std::string::npos; at = trace.find("\"ph\":\"X\"", at + 1)) {
+        ++events;
+    }
+    EXPECT_EQ(events, Profiler::EVENT_CAPACITY);
+    std::remove(path.c_str());
+}
+
+
+/**
+ * Allocation tests, game_tests links the tracking hooks
+ */
+// The hooks see allocations made on this thread
+TEST(AllocTrackerTest, CountsAllocations) {
+    ASSERT_TRUE(AllocTracker::isEnabled());
+    AllocTracker::Counts before = AllocTracker::getThread();
+    std::unique_ptr<std::vector<int>> vector(new std::vector<int>(100));
+    AllocTracker::Counts after = AllocTracker::getThread();
+    EXPECT_EQ(after.allocations - before.allocations, 2u);
+    EXPECT_GE(after.bytes - before.bytes, sizeof(std::vector<int>) + 100 * sizeof(int));
 
-    EXPECT_LE(game.getFruits().size(), Game::getMaxFruits());
+    vector.reset();
+    EXPECT_EQ(AllocTracker::getThread().frees - after.frees, 2u);
+}
+// Once the first second has warmed the stores up, a tick never touches the heap,
+// ghosts and fruits being spawned, moved, eaten and all
+TEST(AllocTrackerTest, SteadyTicksDontAllocate) {
+    const int WARMUP_TICKS = 120;
+    JobSystem jobs(2);
+    for (std::uint64_t seed = 1; seed <= 4; ++seed) {
+        GameSim sim(seed);
+        sim.setJobSystem(&jobs);
+        InputPolicy player(InputPolicy::CHASE, seed);
+        for (int i = 0; i < WARMUP_TICKS; ++i) {
+            sim.setInput(player.next(sim));
+            sim.tick();
+        }
+
+        AllocTracker::Counts before = AllocTracker::getTotal();
+        while (!sim.isGameEnded()) {
+            sim.setInput(player.next(sim));
+            sim.tick();
+        }
+        EXPECT_EQ(AllocTracker::getTotal().allocations - before.allocations, 0u) << "seed " << seed;
+        EXPECT_GT(sim.getGhostsEaten(), 0) << "seed " << seed;
+    }
+}
+// Zones are charged with the allocations made inside them
+TEST(AllocTrackerTest, ZonesCountAllocations) {
+    Profiler::get().endFrame();
+    {
+        ProfileScope scope("allocating");
+        // volatile so the compiler can't leave the allocation out
+        int* volatile value = new int(1);
+        delete value;
+    }
+    Profiler::get().endFrame();
+
+    const std::vector<Profiler::ZoneStats>& zones = Profiler::get().getFrameZones();
+    ASSERT_EQ(zones.size(), 1u);
+    EXPECT_EQ(zones[0].allocations, 1u);
+    EXPECT_EQ(zones[0].bytes, sizeof(int));
+    EXPECT_GE(Profiler::get().getFrameAllocations().allocations, 1u);
+}
+
+
+/**
+ * Batch runner tests
+ */
+// A batch gives the same games whatever the number of threads playing it
+TEST(BatchRunnerTest, ResultsDontDependOnThreads) {
+    SimConfig config;
+    config.totalTime = sf::seconds(5);
+    JobSystem oneThread(0);
+    JobSystem manyThreads(4);
+    BatchRunner serial(config, InputPolicy::CHASE);
+    BatchRunner parallel(config, InputPolicy::CHASE);
+
+    const std::vector<GameResult>& expected = serial.run(64, 7, oneThread);
+    const std::vector<GameResult>& actual = parallel.run(64, 7, manyThreads);
+    ASSERT_EQ(expected.size(), actual.size());
+    // the seed printed in the CSV replays the game on any build
+    EXPECT_EQ(BatchRunner::gameSeed(7, 0), 17454036056956194106ULL);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].seed, BatchRunner::gameSeed(7, i));
+        EXPECT_EQ(expected[i].seed, actual[i].seed);
+        EXPECT_EQ(expected[i].score, actual[i].score);
+        EXPECT_EQ(expected[i].ghostsEaten, actual[i].ghostsEaten);
+        EXPECT_EQ(expected[i].boostUptime, actual[i].boostUptime);
+    }
+}
+// The summary adds up to the games it was given
+TEST(BatchRunnerTest, SummarizeResults) {
+    std::vector<GameResult> results;
+    for (int score = 0; score <= 100; score += 10) {
+        results.push_back({0, score, score / 10, 0.5f});
+    }
+    BatchStats stats = BatchRunner::summarize(results, 5);
+
+    EXPECT_EQ(stats.games, results.size());
+    EXPECT_DOUBLE_EQ(stats.meanScore, 50.0);
+    EXPECT_EQ(stats.minScore, 0);
+    EXPECT_EQ(stats.medianScore, 50);
+    EXPECT_EQ(stats.maxScore, 100);
+    EXPECT_EQ(stats.maxGhostsEaten, 10);
+    EXPECT_NEAR(stats.meanBoostUptime, 0.5, 1e-6);
+    std::size_t histogramGames = 0;
+    for (std::size_t games : stats.histogram) {
+        histogramGames += games;
+    }
+    EXPECT_EQ(histogramGames, results.size());
+}
+
+
+/**
+ * Job system tests
+ */
+// Every index is handed out exactly once, whatever the chunking
+TEST(JobSystemTest, ParallelForCoversEveryIndexOnce) {
+    JobSystem jobs(4);
+    std::vector<int> visits(100003, 0);
+    jobs.parallelFor(visits.size(), 1000, [&visits](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), static_cast<long>(visits.size()));
+}
+// Ghosts end up in the same place whether they're updated on one thread or many
+TEST(JobSystemTest, ParallelGhostUpdateIsDeterministic) {
+    JobSystem jobs(4);
+    GhostStore serial;
+    GhostStore parallel;
+    Rng serialRng(99);
+    Rng parallelRng(99);
+    sf::Time now;
+    for (int i = 0; i < 20000; ++i) {
+        serial.add(sf::Vector2f(960.f, 640.f), now, serialRng);
+        parallel.add(sf::Vector2f(960.f, 640.f), now, parallelRng);
+    }
+    for (int tick = 0; tick < 300; ++tick) {
+        // Turns stay on the calling thread, like the simulation's timers
+        if (tick % 60 == 0) {
+            for (std::size_t i = 0; i < serial.size(); ++i) {
+                serial.turn(i);
+                parallel.turn(i);
+            }
+        }
+        serial.updateMovement();
+        jobs.parallelFor(parallel.size(), 512, [&parallel](std::size_t begin, std::size_t end) {
+            parallel.updateMovement(begin, end);
+        });
+    }
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        ASSERT_EQ(serial.getPosition(i), parallel.getPosition(i));
+    }
 }
 
 
@@ -64,22 +529,25 @@ TEST_F(GameTest, EntitiesSpawnWithinLimits) {
  */
 class GhostTest : public ::testing::Test {
 protected:
-    std::unique_ptr<Ghost> ghost;
+    GhostStore ghosts;
+    std::size_t ghost = 0;
+    sf::Time now;
+    sf::Time nextTurn;
+    Rng rng;
     void SetUp() override {
-        ghost = std::make_unique<Ghost>(sf::Vector2f(100.f, 100.f));
+        ghost = ghosts.add(sf::Vector2f(500.f, 500.f), now, rng);
+        nextTurn = now;
     }
 
     void simulateTime(float seconds) {
-        // We create an initial time point
-        sf::Clock clock;
-        sf::Time elapsedTime = clock.restart();
-        while (elapsedTime.asSeconds() < seconds) {
-            // Update the ghost's movement based on the elapsed time
-            ghost->updateMovement();
-
-            // Add "game ticks"
-            sf::Time frameTime = clock.restart();
-            elapsedTime += frameTime;
+        sf::Time end = now + sf::seconds(seconds);
+        while (now < end) {
+            // Turn when the ghost asks to, then move one game tick at a time
+            if (now >= nextTurn) {
+                nextTurn = now + sf::seconds(ghosts.turn(ghost));
+            }
+            now += GameSim::getTickTime();
+            ghosts.updateMovement(ghost);
         }
     }
 
@@ -89,32 +557,662 @@ protected:
  */
 // Ghost Movement (1): Test to see if ghost stays within boundaries
 TEST_F(GhostTest, RespectBoundary) {
-    const float boundaryX = Game::getSceneWidth() - Ghost::getHitbox();
-    const float boundaryY = Game::getSceneHeight() - Ghost::getHitbox();
+    const float boundaryX = GameSim::getSceneWidth() - Ghost::getHitbox();
+    const float boundaryY = GameSim::getSceneHeight() - Ghost::getHitbox();
 
     // Set ghost near the boundary
-    ghost->setPosition(sf::Vector2f(boundaryX - 1, boundaryY - 1));
+    ghosts.setPosition(ghost, sf::Vector2f(boundaryX - 1, boundaryY - 1));
 
     // Simulate a frame update
     simulateTime(1.0f);
-    ghost->updateMovement();
+    ghosts.updateMovement(ghost);
 
     // Check if ghost is still within boundaries
-    sf::Vector2f newPos = ghost->getPosition();
+    sf::Vector2f newPos = ghosts.getPosition(ghost);
     EXPECT_LE(newPos.x, boundaryX);
     EXPECT_LE(newPos.y, boundaryY);
 }
 
 // Ghost Movement (2): Test to ensure ghost changes direction
 TEST_F(GhostTest, DirectionChange) {
-    sf::Vector2f initialPos = ghost->getPosition();
+    sf::Vector2f initialPos = ghosts.getPosition(ghost);
     // Simulate 10 random movements
     for (int i = 0; i < 10; ++i) {
         simulateTime(0.1f);
-        ghost->updateMovement();
+        ghosts.updateMovement(ghost);
     }
-    sf::Vector2f finalPos = ghost->getPosition();
+    sf::Vector2f finalPos = ghosts.getPosition(ghost);
 
     // Verifies that val1 != val2
     EXPECT_NE(initialPos, finalPos);
-}
\ No newline at end of file
+}
+
+// Removing a ghost moves the last one into its slot and keeps the rest intact
+TEST_F(GhostTest, SwapAndPopRemoval) {
+    std::size_t second = ghosts.add(sf::Vector2f(700.f, 500.f), now, rng);
+    std::size_t third = ghosts.add(sf::Vector2f(900.f, 500.f), now, rng);
+    sf::Vector2f secondPos = ghosts.getPosition(second);
+    sf::Vector2f thirdPos = ghosts.getPosition(third);
+    Ghost::Color thirdColor = ghosts.getColor(third);
+
+    ghosts.remove(ghost);
+
+    ASSERT_EQ(ghosts.size(), 2u);
+    EXPECT_EQ(ghosts.getPosition(0), thirdPos);
+    EXPECT_EQ(ghosts.getColor(0), thirdColor);
+    EXPECT_EQ(ghosts.getPosition(1), secondPos);
+}
+// Ids follow a ghost through swap-and-pop, and a removed ghost's id goes stale
+TEST_F(GhostTest, IdsSurviveRemoval) {
+    std::size_t second = ghosts.add(sf::Vector2f(700.f, 500.f), now, rng);
+    std::uint32_t firstId = ghosts.getId(ghost);
+    std::uint32_t firstGeneration = ghosts.getGeneration(firstId);
+    std::uint32_t secondId = ghosts.getId(second);
+    std::uint32_t secondGeneration = ghosts.getGeneration(secondId);
+
+    ghosts.remove(ghost);
+
+    std::size_t index;
+    EXPECT_FALSE(ghosts.findIndex(firstId, firstGeneration, index));
+    ASSERT_TRUE(ghosts.findIndex(secondId, secondGeneration, index));
+    EXPECT_EQ(index, 0u);
+
+    // The freed id comes back with a new generation
+    std::size_t third = ghosts.add(sf::Vector2f(900.f, 500.f), now, rng);
+    EXPECT_EQ(ghosts.getId(third), firstId);
+    EXPECT_FALSE(ghosts.findIndex(firstId, firstGeneration, index));
+}
+// Chasing ghosts close in on the field's target, fleeing ones get away and wandering ones ignore it
+TEST_F(GhostTest, BehaviorsFollowTheField) {
+    FlowField field(GameSim::getSceneWidth(), GameSim::getSceneHeight(), 80.f);
+    field.update(sf::Vector2f(1500.f, 1000.f));
+    const GhostBehavior chase[Ghost::COLOR_COUNT] = {GHOST_CHASE, GHOST_CHASE, GHOST_CHASE, GHOST_CHASE};
+    const GhostBehavior flee[Ghost::COLOR_COUNT] = {GHOST_FLEE, GHOST_FLEE, GHOST_FLEE, GHOST_FLEE};
+    GhostStore chasers;
+    GhostStore fleers;
+    chasers.setBehaviors(chase);
+    fleers.setBehaviors(flee);
+    std::size_t chaser = chasers.add(sf::Vector2f(500.f, 500.f), now, rng);
+    std::size_t fleer = fleers.add(sf::Vector2f(500.f, 500.f), now, rng);
+    std::uint16_t start = field.getDistance(sf::Vector2f(500.f, 500.f));
+
+    // Ten cells' worth of one pixel steps
+    for (int tick = 0; tick < 800; ++tick) {
+        chasers.updateMovement(&field);
+        fleers.updateMovement(&field);
+        ghosts.updateMovement(&field);
+    }
+    EXPECT_LE(field.getDistance(chasers.getPosition(chaser)), start - 9);
+    EXPECT_GT(field.getDistance(fleers.getPosition(fleer)), start);
+    EXPECT_EQ(ghosts.getPosition(ghost), sf::Vector2f(500.f, 500.f));
+}
+
+
+/**
+ * Flow field tests
+ */
+// Distances and steps are measured from the target's cell, and only rebuilt when it changes cell
+TEST(FlowFieldTest, PointsTowardAndAwayFromTarget) {
+    FlowField field(800.f, 800.f, 80.f);
+    EXPECT_TRUE(field.update(sf::Vector2f(400.f, 400.f)));
+    EXPECT_FALSE(field.update(sf::Vector2f(420.f, 430.f)));
+    EXPECT_EQ(field.getDistance(sf::Vector2f(400.f, 400.f)), 0u);
+    EXPECT_EQ(field.getDistance(sf::Vector2f(40.f, 440.f)), 5u);
+    EXPECT_EQ(field.getDistance(sf::Vector2f(40.f, 40.f)), 10u);
+
+    EXPECT_EQ(field.getToward(40.f, 440.f), FlowField::RIGHT);
+    EXPECT_EQ(field.getToward(440.f, 40.f), FlowField::DOWN);
+    EXPECT_EQ(field.getToward(400.f, 400.f), FlowField::STAY);
+    EXPECT_EQ(field.getAway(200.f, 440.f), FlowField::LEFT);
+    // Cornered, nowhere is further away
+    EXPECT_EQ(field.getAway(40.f, 40.f), FlowField::STAY);
+
+    EXPECT_TRUE(field.update(sf::Vector2f(600.f, 400.f)));
+    EXPECT_EQ(field.getDistance(sf::Vector2f(40.f, 440.f)), 7u);
+}
+
+
+/**
+ * World tests
+ */
+// A larger world starts the player in its middle and spreads ghosts and fruits over all of it
+TEST(WorldTest, EntitiesUseTheWholeWorld) {
+    SimConfig config;
+    config.worldScale = 4;
+    config.maxGhosts = 200;
+    config.ghostSpawnDelayMax = 0.05f;
+    GameSim sim(3, config);
+    sf::Vector2f world = sim.getWorldSize();
+    EXPECT_FLOAT_EQ(world.x, 4 * GameSim::getSceneWidth());
+    EXPECT_EQ(sim.getPlayerPosition(), world / 2.0f);
+
+    // Player walks to the far corner, past where the first screen ends
+    sim.setInput(INPUT_RIGHT | INPUT_DOWN);
+    bool offFirstScreen = false;
+    for (int i = 0; i < 1200 && !sim.isGameEnded(); ++i) {
+        sim.tick();
+        const GhostStore& ghosts = sim.getGhosts();
+        for (std::size_t g = 0; g < ghosts.size(); ++g) {
+            sf::Vector2f position = ghosts.getPosition(g);
+            ASSERT_TRUE(position.x >= 0 && position.x <= world.x && position.y >= 0 && position.y <= world.y);
+            offFirstScreen |= position.x > GameSim::getSceneWidth() || position.y > GameSim::getSceneHeight();
+        }
+    }
+    EXPECT_TRUE(offFirstScreen);
+    EXPECT_GT(sim.getPlayerPosition().x, GameSim::getSceneWidth() * 2);
+    EXPECT_LE(sim.getPlayerPosition().x, world.x);
+}
+
+
+/**
+ * Entity tests
+ */
+// A new kind only needs its traits, here a faster and smaller kind with one look
+struct PelletTraits {
+    enum Look { PELLET, LOOK_COUNT };
+    static constexpr float HITBOX = 10.0f;
+    static constexpr float MIN_SPAWN_DISTANCE = 300.0f;
+    static constexpr float SPAWN_MARGIN = 20.0f;
+    static constexpr int MAX_SPAWN_ATTEMPTS = 64;
+    static constexpr float SPEED = 3.0f;
+};
+using Pellet = Entity<PelletTraits>;
+
+TEST(EntityTest, KindsFollowTheirTraits) {
+    EXPECT_FLOAT_EQ(Pellet::getHitbox(), 10.0f);
+    EXPECT_FLOAT_EQ(Ghost::getHitbox(), 40.0f);
+    EXPECT_FLOAT_EQ(Fruit::getHitbox(), 30.0f);
+
+    // Moves at its own speed and stops a hitbox away from the edge
+    sf::Vector2f scene = GameSim::getSceneSize();
+    float x = 100.0f;
+    float y = 100.0f;
+    Pellet::step(x, y, 1.0f, 0.0f, scene);
+    EXPECT_FLOAT_EQ(x, 103.0f);
+    x = 12.0f;
+    Pellet::step(x, y, -1.0f, 0.0f, scene);
+    EXPECT_FLOAT_EQ(x, 10.0f);
+
+    SpatialGrid ghostGrid(scene.x, scene.y, 80.0f);
+    SpatialGrid fruitGrid(scene.x, scene.y, 80.0f);
+    Rng rng(5);
+    sf::Vector2f player(960.f, 640.f);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(Pellet::randLook(rng), Pellet::PELLET);
+        sf::Vector2f d = Pellet::randSpawn(player, scene, rng, ghostGrid, fruitGrid) - player;
+        EXPECT_GE(std::sqrt(d.x * d.x + d.y * d.y), 300.0f);
+    }
+}
+
+
+/**
+ * Snapshot tests
+ */
+// The reader always gets the newest published copy, and keeps it until there's a newer one
+TEST(TripleBufferTest, ReaderGetsLatest) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.update());
+    buffer.getBack() = 1;
+    buffer.publish();
+    buffer.getBack() = 2;
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.getFront(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.getFront(), 2);
+
+    buffer.getBack() = 3;
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.getFront(), 3);
+}
+// A copy is never written while the reader holds it, and values only move forward
+TEST(TripleBufferTest, ThreadsNeverShareACopy) {
+    const int COUNT = 100000;
+    TripleBuffer<std::pair<int, int>> buffer;
+    std::thread writer([&buffer]() {
+        for (int i = 1; i <= COUNT; ++i) {
+            buffer.getBack().first = i;
+            buffer.getBack().second = -i;
+            buffer.publish();
+        }
+    });
+    int last = 0;
+    while (last < COUNT) {
+        if (buffer.update()) {
+            const std::pair<int, int>& value = buffer.getFront();
+            ASSERT_EQ(value.first, -value.second);
+            ASSERT_GT(value.first, last);
+            last = value.first;
+        }
+    }
+    writer.join();
+}
+// A snapshot holds what the renderer needs of the tick it was taken on
+TEST_F(GameTest, SnapshotCapturesTick) {
+    simulateTime(3.0f);
+    Snapshot snapshot;
+    snapshot.reserve(game.getConfig());
+    snapshot.capture(game, sf::seconds(3));
+
+    EXPECT_EQ(snapshot.tick, game.getTickCount());
+    EXPECT_EQ(snapshot.playerPosition, game.getPlayerPosition());
+    ASSERT_EQ(snapshot.ghosts.size(), game.getGhosts().size());
+    for (std::size_t i = 0; i < snapshot.ghosts.size(); ++i) {
+        EXPECT_EQ(snapshot.ghosts[i].position, game.getGhosts().getPosition(i));
+        EXPECT_EQ(snapshot.ghosts[i].look, game.getGhosts().getColor(i));
+    }
+    EXPECT_EQ(snapshot.fruits.size(), game.getFruits().size());
+    EXPECT_EQ(snapshot.score, game.getScore());
+    EXPECT_EQ(snapshot.timeLeft, game.getTimeLeft());
+}
+
+
+/**
+ * Save state tests
+ */
+// Restoring a save and playing the same inputs plays out the same game, in the same sim or another one
+TEST(SaveStateTest, RestoreReplaysTheSameGame) {
+    GameSim sim(21);
+    InputPolicy player(InputPolicy::CHASE, 21);
+    for (int i = 0; i < 600; ++i) {
+        sim.setInput(player.next(sim));
+        sim.tick();
+    }
+    SaveState state;
+    sim.save(state);
+    std::vector<std::uint8_t> inputs;
+    for (int i = 0; i < 1200; ++i) {
+        inputs.push_back(player.next(sim));
+        sim.setInput(inputs.back());
+        sim.tick();
+    }
+
+    GameSim other(99);
+    GameSim* restored[2] = {&other, &sim};
+    for (GameSim* copy : restored) {
+        ASSERT_EQ(copy->restore(state), 0);
+        EXPECT_EQ(copy->getSeed(), 21u);
+        EXPECT_EQ(copy->getTickCount(), 600u);
+        for (std::uint8_t input : inputs) {
+            copy->setInput(input);
+            copy->tick();
+        }
+    }
+    EXPECT_EQ(other.getScore(), sim.getScore());
+    EXPECT_EQ(other.getGhostsEaten(), sim.getGhostsEaten());
+    EXPECT_EQ(other.getPlayerPosition(), sim.getPlayerPosition());
+    ASSERT_EQ(other.getGhosts().size(), sim.getGhosts().size());
+    for (std::size_t i = 0; i < sim.getGhosts().size(); ++i) {
+        EXPECT_EQ(other.getGhosts().getPosition(i), sim.getGhosts().getPosition(i));
+    }
+    EXPECT_EQ(other.getFruits().size(), sim.getFruits().size());
+    EXPECT_GT(sim.getGhostsEaten(), 0);
+}
+// A full game saves within the reserved size, and saving and restoring it doesn't allocate
+TEST(SaveStateTest, SaveAndRestoreDontAllocate) {
+    SimConfig config;
+    std::fill(std::begin(config.ghostBehaviors), std::end(config.ghostBehaviors), GHOST_WANDER);
+    GameSim sim(8, config);
+    std::size_t maxSize = sim.getMaxSaveSize();
+    SaveState state;
+    state.reserve(maxSize);
+    while (sim.getGhosts().size() < static_cast<std::size_t>(config.maxGhosts) && !sim.isGameEnded()) {
+        sim.tick();
+    }
+    ASSERT_EQ(sim.getGhosts().size(), static_cast<std::size_t>(config.maxGhosts));
+
+    AllocTracker::Counts before = AllocTracker::getTotal();
+    sim.save(state);
+    EXPECT_EQ(sim.restore(state), 0);
+    EXPECT_EQ(AllocTracker::getTotal().allocations - before.allocations, 0u);
+    EXPECT_LE(state.size(), maxSize);
+    EXPECT_EQ(sim.restore(SaveState()), 1);
+}
+// Popping steps back one tick at a time through the last states pushed
+TEST(RewindBufferTest, PopsNewestFirst) {
+    GameSim sim(3);
+    RewindBuffer rewind(4);
+    rewind.reserve(sim);
+    for (int i = 0; i < 6; ++i) {
+        rewind.push(sim);
+        sim.tick();
+    }
+    // Ticks 0 to 5 were pushed, the ring only kept the last four
+    EXPECT_EQ(rewind.size(), 4u);
+    for (std::uint32_t tick = 5; tick >= 2; --tick) {
+        ASSERT_EQ(rewind.pop(sim), 0);
+        EXPECT_EQ(sim.getTickCount(), tick);
+    }
+    EXPECT_EQ(rewind.pop(sim), 1);
+    EXPECT_EQ(sim.getTickCount(), 2u);
+}
+
+
+/**
+ * Multiplayer and network tests
+ */
+static std::vector<std::uint32_t> entityFields(const std::vector<NetState::Entity>& entities) {
+    std::vector<std::uint32_t> fields;
+    for (const NetState::Entity& entity : entities) {
+        fields.insert(fields.end(), {entity.id, static_cast<std::uint32_t>(entity.x),
+                                     static_cast<std::uint32_t>(entity.y), entity.look});
+    }
+    return fields;
+}
+// Each player moves on its own input, and they share the ghosts
+TEST(MultiplayerTest, PlayersMoveOnTheirOwn) {
+    SimConfig config;
+    config.players = 2;
+    GameSim sim(5, config);
+    ASSERT_EQ(sim.getPlayerCount(), 2u);
+    sf::Vector2f first = sim.getPlayerPosition(0);
+    sf::Vector2f second = sim.getPlayerPosition(1);
+    EXPECT_NE(first, second);
+
+    sim.setInput(INPUT_RIGHT, 0);
+    sim.setInput(INPUT_UP, 1);
+    sim.tick();
+    EXPECT_GT(sim.getPlayerPosition(0).x, first.x);
+    EXPECT_EQ(sim.getPlayerPosition(0).y, first.y);
+    EXPECT_LT(sim.getPlayerPosition(1).y, second.y);
+    EXPECT_EQ(sim.getPlayerPosition(1).x, second.x);
+    EXPECT_EQ(sim.getScore(1), 0);
+}
+// A state coded against an older one decodes to the same state, in fewer bytes than a whole one
+TEST(NetStateTest, DeltaRoundTrips) {
+    SimConfig config;
+    config.players = 2;
+    GameSim sim(13, config);
+    std::uint32_t sequences[2] = {0, 0};
+    NetState baseline;
+    for (int i = 0; i < 600; ++i) {
+        sim.setInput(INPUT_RIGHT, 0);
+        sim.tick();
+    }
+    baseline.capture(sim, 0, sequences);
+    for (int i = 0; i < 3; ++i) {
+        sim.tick();
+    }
+    sequences[0] = 3;
+    NetState current;
+    current.capture(sim, 0, sequences);
+    ASSERT_FALSE(current.ghosts.empty());
+
+    std::vector<std::uint8_t> full;
+    std::vector<std::uint8_t> delta;
+    ByteWriter fullWriter(full);
+    current.encode(nullptr, fullWriter);
+    ByteWriter deltaWriter(delta);
+    current.encode(&baseline, deltaWriter);
+    EXPECT_LT(delta.size(), full.size());
+
+    NetState fromFull;
+    ByteReader fullReader(full.data(), full.size());
+    ASSERT_TRUE(fromFull.decode(nullptr, fullReader));
+    EXPECT_TRUE(fullReader.atEnd());
+    NetState fromDelta;
+    ByteReader deltaReader(delta.data(), delta.size());
+    ASSERT_TRUE(fromDelta.decode(&baseline, deltaReader));
+    for (const NetState* decoded : {&fromFull, &fromDelta}) {
+        EXPECT_EQ(decoded->timeLeftMs, current.timeLeftMs);
+        ASSERT_EQ(decoded->players.size(), 2u);
+        EXPECT_EQ(decoded->players[0].x, current.players[0].x);
+        EXPECT_EQ(decoded->players[0].inputSequence, 3u);
+        EXPECT_EQ(entityFields(decoded->ghosts), entityFields(current.ghosts));
+        EXPECT_EQ(entityFields(decoded->fruits), entityFields(current.fruits));
+    }
+
+    // Cut short, the state is refused rather than half read
+    NetState truncated;
+    ByteReader shortReader(delta.data(), delta.size() - 1);
+    EXPECT_FALSE(truncated.decode(&baseline, shortReader));
+}
+// A client on loopback joins a local server, follows its world and predicts its player
+TEST(NetTest, LoopbackClientFollowsServer) {
+    SimConfig config;
+    config.players = 2;
+    NetServer server(17, config);
+    ASSERT_EQ(server.start(sf::Socket::AnyPort), 0);
+    NetClient client;
+    ASSERT_EQ(client.join(sf::IpAddress::LocalHost, server.getPort()), 0);
+
+    // Delivery on loopback is quick but not instant, so each side gives the other a moment
+    std::uint32_t sent = 0;
+    for (int i = 0; i < 120; ++i) {
+        client.update(INPUT_RIGHT, sf::milliseconds(i * 8));
+        // an input goes out on every update once connected
+        if (client.isConnected()) {
+            ++sent;
+        }
+        sf::sleep(sf::milliseconds(1));
+        server.receive();
+        server.tick();
+        sf::sleep(sf::milliseconds(1));
+    }
+    ASSERT_TRUE(client.isConnected());
+    EXPECT_EQ(server.getClientCount(), 1u);
+    EXPECT_EQ(client.getPlayerIndex(), 0u);
+    EXPECT_EQ(client.getConfig().players, 2);
+    for (int i = 0; i < 100 && client.getState().tick != server.getSim().getTickCount(); ++i) {
+        sf::sleep(sf::milliseconds(1));
+        client.receive();
+    }
+    client.update(INPUT_RIGHT, sf::seconds(1));
+    ++sent;
+
+    // The client's newest state is the server's world, quantized
+    const NetState& state = client.getState();
+    ASSERT_EQ(state.tick, server.getSim().getTickCount());
+    std::uint32_t sequences[2] = {0, 0};
+    NetState expected;
+    expected.capture(server.getSim(), server.getRound(), sequences);
+    EXPECT_EQ(entityFields(state.ghosts), entityFields(expected.ghosts));
+    EXPECT_EQ(entityFields(state.fruits), entityFields(expected.fruits));
+    EXPECT_EQ(state.players[0].x, expected.players[0].x);
+    EXPECT_EQ(state.players[1].x, expected.players[1].x);
+
+    // The player is where the server put it, moved on by the inputs it hasn't applied yet
+    ASSERT_LE(state.players[0].inputSequence, sent);
+    EXPECT_LT(state.players[0].inputSequence, sent);
+    sf::Vector2f expectedPosition = server.getSim().getPlayerPosition(0);
+    for (std::uint32_t s = state.players[0].inputSequence; s < sent; ++s) {
+        expectedPosition = GameSim::movePlayer(expectedPosition, INPUT_RIGHT, config.basePlayerSpeed,
+                                               server.getSim().getWorldSize());
+    }
+    EXPECT_NEAR(client.getPredictedPosition().x, expectedPosition.x, 0.25f);
+    EXPECT_NEAR(client.getPredictedPosition().y, expectedPosition.y, 0.25f);
+
+    // Deltas keep the traffic well under a whole state per tick
+    std::vector<std::uint8_t> full;
+    ByteWriter writer(full);
+    expected.encode(nullptr, writer);
+    EXPECT_GT(client.getBytesPerTick(), 0.0);
+    EXPECT_LT(client.getBytesPerTick(), static_cast<double>(full.size()));
+    EXPECT_GT(server.getBytesPerTick(), 0.0);
+
+    client.leave();
+    sf::sleep(sf::milliseconds(5));
+    server.receive();
+    EXPECT_EQ(server.getClientCount(), 0u);
+}
+
+
+/**
+ * Asset bundle tests
+ */
+// Assets written by the baker come back byte for byte from the mapped file, and a cut file is refused
+TEST(AssetBundleTest, WritesAndMapsBack) {
+    const std::string path = "asset_bundle_test.bundle";
+    const std::uint8_t pixels[8] = {255, 0, 0, 255, 0, 0, 255, 128};
+    const std::vector<std::uint8_t> font = {1, 2, 3};
+    AssetBundleWriter writer;
+    writer.addImage("resources/two.png", 2, 1, pixels);
+    writer.addFile("resources/font.ttf", font);
+    ASSERT_EQ(writer.write(path), 0);
+
+    AssetBundle bundle;
+    ASSERT_EQ(bundle.open(path), 0);
+    EXPECT_EQ(bundle.getEntryCount(), 2u);
+    const AssetBundle::Entry* image = bundle.find("resources/two.png");
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->width, 2u);
+    EXPECT_EQ(image->height, 1u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(bundle.getData(*image)) % 16, 0u);
+    EXPECT_EQ(std::vector<std::uint8_t>(bundle.getData(*image), bundle.getData(*image) + image->size),
+              std::vector<std::uint8_t>(pixels, pixels + 8));
+    const AssetBundle::Entry* file = bundle.find("resources/font.ttf");
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->width, 0u);
+    EXPECT_EQ(std::vector<std::uint8_t>(bundle.getData(*file), bundle.getData(*file) + file->size), font);
+    EXPECT_EQ(bundle.find("resources/missing.png"), nullptr);
+    std::size_t size = bundle.getSize();
+    // Cut in the middle of the font, which would then run past the end of the file
+    auto cut = static_cast<std::size_t>(file->offset + 1);
+    bundle.close();
+
+    std::vector<char> bytes(size);
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(in, nullptr);
+    ASSERT_EQ(std::fread(bytes.data(), 1, size, in), size);
+    std::fclose(in);
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(out, nullptr);
+    std::fwrite(bytes.data(), 1, cut, out);
+    std::fclose(out);
+    EXPECT_EQ(bundle.open(path), 1);
+    EXPECT_FALSE(bundle.isOpen());
+    std::remove(path.c_str());
+}
+// Shrinking averages the pixels under each new one, and transparent pixels don't darken the color
+TEST(AssetBundleTest, DownsampleWeightsColorByAlpha) {
+    // 4x2: an opaque red pixel beside three transparent black ones, then a flat gray block
+    const std::uint8_t pixels[32] = {
+            255, 0, 0, 255, 0, 0, 0, 0, 100, 100, 100, 255, 100, 100, 100, 255,
+            0, 0, 0, 0, 0, 0, 0, 0, 100, 100, 100, 255, 100, 100, 100, 255};
+    std::vector<std::uint8_t> resized;
+    AssetBundle::downsample(pixels, 4, 2, 2, 1, resized);
+    ASSERT_EQ(resized.size(), 8u);
+    EXPECT_EQ(std::vector<std::uint8_t>(resized.begin(), resized.begin() + 4),
+              std::vector<std::uint8_t>({255, 0, 0, 64}));
+    EXPECT_EQ(std::vector<std::uint8_t>(resized.begin() + 4, resized.end()),
+              std::vector<std::uint8_t>({100, 100, 100, 255}));
+}
+
+
+/**
+ * Input tests
+ */
+// A press and release between two ticks still reaches the tick after them, and
+// changes stamped after a tick's time wait for the next tick
+TEST(InputQueueTest, ShortPressesRegister) {
+    InputQueue input;
+    input.keyChanged(INPUT_LEFT, true, sf::milliseconds(1));
+    input.keyChanged(INPUT_LEFT, false, sf::milliseconds(3));
+    input.keyChanged(INPUT_UP, true, sf::milliseconds(12));
+
+    EXPECT_EQ(input.take(sf::milliseconds(8)), INPUT_LEFT);
+    EXPECT_EQ(input.getTaken(), 2u);
+    EXPECT_EQ(input.take(sf::milliseconds(16)), INPUT_UP);
+    EXPECT_EQ(input.take(sf::milliseconds(25)), INPUT_UP);
+
+    // Two keys on one direction hold it until both are released
+    input.keyChanged(INPUT_UP, true, sf::milliseconds(26));
+    input.keyChanged(INPUT_UP, false, sf::milliseconds(27));
+    EXPECT_EQ(input.take(sf::milliseconds(33)), INPUT_UP);
+    input.releaseAll(sf::milliseconds(34));
+    EXPECT_EQ(input.take(sf::milliseconds(41)), INPUT_NONE);
+}
+// Each change is timed from when it was seen to when a frame showing it was displayed
+TEST(InputQueueTest, MeasuresLatency) {
+    InputQueue input;
+    EXPECT_EQ(input.getLatencyReport().samples, 0u);
+    for (int i = 0; i < 20; ++i) {
+        input.keyChanged(INPUT_RIGHT, i % 2 == 0, sf::milliseconds(100 * i));
+        input.take(sf::milliseconds(100 * i + 8));
+        input.presented(input.getTaken(), sf::milliseconds(100 * i + 10 + i));
+    }
+    InputQueue::LatencyReport report = input.getLatencyReport();
+    EXPECT_EQ(report.samples, 20u);
+    EXPECT_EQ(report.median, sf::milliseconds(20));
+    EXPECT_EQ(report.max, sf::milliseconds(29));
+    // Nothing new on screen, nothing new measured
+    input.presented(input.getTaken(), sf::seconds(10));
+    EXPECT_EQ(input.getLatencyReport().samples, 20u);
+}
+
+
+/**
+ * Pool tests
+ */
+// Slots keep their number while in use and are handed out again once released
+TEST(PoolTest, RecyclesSlots) {
+    Pool<int> pool(3);
+    std::uint32_t a = pool.acquire();
+    std::uint32_t b = pool.acquire();
+    std::uint32_t c = pool.acquire();
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(b, 1u);
+    EXPECT_EQ(c, 2u);
+    EXPECT_EQ(pool.acquire(), Pool<int>::NONE);
+
+    pool[a] = 10;
+    pool[c] = 30;
+    pool.release(b);
+    EXPECT_EQ(pool.size(), 2u);
+    std::vector<int> seen;
+    for (int value : pool) {
+        seen.push_back(value);
+    }
+    EXPECT_EQ(seen, std::vector<int>({10, 30}));
+
+    EXPECT_EQ(pool.acquire(), b);
+    EXPECT_EQ(pool.capacity(), 3u);
+}
+// Growing keeps the slots in use where they are
+TEST(PoolTest, ReserveKeepsSlots) {
+    Pool<int> pool(1);
+    std::uint32_t first = pool.acquire();
+    pool[first] = 7;
+    pool.reserve(4);
+    EXPECT_EQ(pool[first], 7);
+    EXPECT_TRUE(pool.isAlive(first));
+    EXPECT_EQ(pool.acquire(), 1u);
+}
+
+
+/**
+ * Timer wheel tests
+ */
+// Timers fire on their tick in the order they were scheduled, even a full turn of the wheel away
+TEST(TimerWheelTest, FiresOnTheirTick) {
+    TimerWheel timers(8);
+    timers.schedule({3, 0, 1, 0});
+    timers.schedule({3, 0, 2, 0});
+    timers.schedule({11, 0, 3, 0}); // same slot as tick 3
+    timers.schedule({5, 0, 4, 0});
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> fired;
+    for (std::uint32_t tick = 1; tick <= 12; ++tick) {
+        timers.advance(tick, [&](const TimerWheel::Timer& timer) {
+            fired.emplace_back(tick, timer.target);
+            // rescheduling from a timer lands on a later tick
+            if (timer.target == 4) {
+                timers.schedule({tick, 0, 5, 0});
+            }
+        });
+    }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> expected = {{3, 1}, {3, 2}, {5, 4}, {6, 5}, {11, 3}};
+    EXPECT_EQ(fired, expected);
+    EXPECT_EQ(timers.size(), 0u);
+}
+// Boosts end on time, and a second fruit pushes the end back
+TEST_F(GameTest, SpeedBoostExpires) {
+    giveBoost(10);
+    ticks(5);
+    giveBoost(10);
+    ticks(6);
+    EXPECT_TRUE(game.isSpeedBoosted());
+    ticks(4);
+    EXPECT_FALSE(game.isSpeedBoosted());
+}
@@ -6,161 +6,262 @@
  */
 
 #include "ghost.h"
-#include "game.h"
+#include "game_sim.h"
+#include <algorithm>
+#include <iterator>
 
-const float Ghost::HITBOX = 40.0f;
-const float Ghost::MIN_SPAWN_DISTANCE = 150.0f;
-const float Ghost::MAX_SPAWN_DISTANCE_X = Game::getSceneWidth() - 20.0f;
-const float Ghost::MAX_SPAWN_DISTANCE_Y = Game::getSceneHeight() - 20.0f;
-// Defining this here too so that it doesn't despawn when generating new ghosts
-sf::Texture Ghost::blueTexture;
-sf::Texture Ghost::orangeTexture;
-sf::Texture Ghost::pinkTexture;
-sf::Texture Ghost::redTexture;
+constexpr int GhostTraits::LOOK_COUNT;
+constexpr float GhostTraits::HITBOX;
+constexpr float GhostTraits::MIN_SPAWN_DISTANCE;
+constexpr float GhostTraits::SPAWN_MARGIN;
+constexpr int GhostTraits::MAX_SPAWN_ATTEMPTS;
+constexpr float GhostTraits::SPEED;
 
+
+GhostStore::GhostStore() : bounds(GameSim::getSceneSize()) {
+    std::fill(std::begin(behaviorByColor), std::end(behaviorByColor), GHOST_WANDER);
+}
 /**
- * Ghost constructor
+ * Set how ghosts of each color move, ghosts already in the store keep theirs
  */
-Ghost::Ghost(const sf::Vector2f& playerPosition) {
-    loadTextures();
-    assignRandomTexture();
-    sf::Vector2f spawnPosition = randSpawn(playerPosition);
-    decideNextMovement();
-    initGhost(spawnPosition);
+void GhostStore::setBehaviors(const GhostBehavior (&byColor)[Ghost::COLOR_COUNT]) {
+    std::copy(std::begin(byColor), std::end(byColor), std::begin(behaviorByColor));
 }
 /**
- * Load textures if they haven't been loaded already
+ * Reserve room for the given number of ghosts in every array
  */
-int Ghost::loadTextures() {
-    if (blueTexture.getSize().x == 0) {
-        blueTexture.loadFromFile("resources/blue.png");
-        return 0;
-    }
-    if (orangeTexture.getSize().x == 0) {
-        orangeTexture.loadFromFile("resources/orange.png");
-        return 0;
-    }
-    if (pinkTexture.getSize().x == 0) {
-        pinkTexture.loadFromFile("resources/pink.png");
-        return 0;
+void GhostStore::reserve(std::size_t capacity) {
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    dirX.reserve(capacity);
+    dirY.reserve(capacity);
+    spawnTime.reserve(capacity);
+    color.reserve(capacity);
+    behavior.reserve(capacity);
+    movementRng.reserve(capacity);
+    ids.reserve(capacity);
+    idIndex.reserve(capacity);
+    idGeneration.reserve(capacity);
+    freeIds.reserve(capacity);
+}
+/**
+ * Add a new ghost at the given position, reusing the id of a removed ghost if there is one
+ * @return the index of the new ghost
+ */
+std::size_t GhostStore::add(const sf::Vector2f& position, sf::Time now, Rng& rng) {
+    std::uint32_t id;
+    if (freeIds.empty()) {
+        id = static_cast<std::uint32_t>(idIndex.size());
+        idIndex.push_back(0);
+        idGeneration.push_back(0);
+    } else {
+        id = freeIds.back();
+        freeIds.pop_back();
     }
-    if (redTexture.getSize().x == 0) {
-        redTexture.loadFromFile("resources/red.png");
-        return 0;
+    idIndex[id] = static_cast<std::uint32_t>(size());
+    ids.push_back(id);
+
+    color.push_back(Ghost::randLook(rng));
+    behavior.push_back(behaviorByColor[color.back()]);
+    movementRng.push_back(rng.split());
+
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    prevX.push_back(position.x);
+    prevY.push_back(position.y);
+    dirX.push_back(0.0f);
+    dirY.push_back(0.0f);
+    spawnTime.push_back(now);
+    return size() - 1;
+}
+/**
+ * Remove a ghost in O(1) by moving the last ghost into its slot
+ */
+void GhostStore::remove(std::size_t index) {
+    std::size_t last = size() - 1;
+    releaseId(ids[index]);
+    if (index != last) {
+        posX[index] = posX[last];
+        posY[index] = posY[last];
+        prevX[index] = prevX[last];
+        prevY[index] = prevY[last];
+        dirX[index] = dirX[last];
+        dirY[index] = dirY[last];
+        spawnTime[index] = spawnTime[last];
+        color[index] = color[last];
+        behavior[index] = behavior[last];
+        movementRng[index] = movementRng[last];
+        ids[index] = ids[last];
+        idIndex[ids[index]] = static_cast<std::uint32_t>(index);
     }
-    return 1;
+    posX.pop_back();
+    posY.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    dirX.pop_back();
+    dirY.pop_back();
+    spawnTime.pop_back();
+    color.pop_back();
+    behavior.pop_back();
+    movementRng.pop_back();
+    ids.pop_back();
 }
 /**
- * Random texture for a ghost
+ * Remove every ghost, keeping the reserved memory
  */
-void Ghost::assignRandomTexture() {
-    std::random_device rd;
-    std::mt19937 eng(rd());
-    std::uniform_int_distribution<> distr(0, 3);
-
-    int textureChoice = distr(eng);
-    if (textureChoice == 0) {
-        ghost.setTexture(&blueTexture);
-    } else if (textureChoice == 1) {
-        ghost.setTexture(&orangeTexture);
-    } else if (textureChoice == 2) {
-        ghost.setTexture(&pinkTexture);
-    } else if (textureChoice == 3) {
-        ghost.setTexture(&redTexture);
+void GhostStore::clear() {
+    for (std::uint32_t id : ids) {
+        releaseId(id);
     }
+    ids.clear();
+    posX.clear();
+    posY.clear();
+    prevX.clear();
+    prevY.clear();
+    dirX.clear();
+    dirY.clear();
+    spawnTime.clear();
+    color.clear();
+    behavior.clear();
+    movementRng.clear();
 }
 
 
 /**
- * Ghost initializer
+ * Copy out every array as is
  */
-int Ghost::initGhost(const sf::Vector2f& spawnPosition) {
-    ghost.setRadius(HITBOX);
-    ghost.setOrigin(HITBOX, HITBOX);
-    loadTextures();
-    assignRandomTexture();
-    ghost.setPosition(spawnPosition);
-    return 0;
+void GhostStore::save(SaveState& state) const {
+    state.writeVector(posX);
+    state.writeVector(posY);
+    state.writeVector(prevX);
+    state.writeVector(prevY);
+    state.writeVector(dirX);
+    state.writeVector(dirY);
+    state.writeVector(spawnTime);
+    state.writeVector(color);
+    state.writeVector(behavior);
+    state.writeVector(movementRng);
+    state.writeVector(ids);
+    state.writeVector(idIndex);
+    state.writeVector(idGeneration);
+    state.writeVector(freeIds);
+}
+/**
+ * Copy every array back, within the capacity reserve() gave them
+ */
+void GhostStore::restore(const SaveState& state, std::size_t& offset) {
+    state.readVector(offset, posX);
+    state.readVector(offset, posY);
+    state.readVector(offset, prevX);
+    state.readVector(offset, prevY);
+    state.readVector(offset, dirX);
+    state.readVector(offset, dirY);
+    state.readVector(offset, spawnTime);
+    state.readVector(offset, color);
+    state.readVector(offset, behavior);
+    state.readVector(offset, movementRng);
+    state.readVector(offset, ids);
+    state.readVector(offset, idIndex);
+    state.readVector(offset, idGeneration);
+    state.readVector(offset, freeIds);
 }
-
 /**
- * Generate a random spawn position for a ghost
- * @return the spawn position
- */
-sf::Vector2f Ghost::randSpawn(const sf::Vector2f& playerPosition) {
-    std::random_device rd;
-    std::mt19937 eng(rd());
-    std::uniform_real_distribution<> distrX(20.0f, MAX_SPAWN_DISTANCE_X);
-    std::uniform_real_distribution<> distrY(20.0f, MAX_SPAWN_DISTANCE_Y);
+ * A ghost's slot in each per-ghost array, plus its id's entry in the id
+ * tables. A live id and a free one take the same room, since ids and freeIds
+ * together never hold more ids than the id tables.
+ */
+std::size_t GhostStore::getSavedBytesPerGhost() {
+    return 6 * sizeof(float) + sizeof(sf::Time) + 2 * sizeof(std::uint8_t) + sizeof(Rng) +
+           3 * sizeof(std::uint32_t);
+}
 
-    sf::Vector2f spawnPosition;
-    float distance;
-    do {
-        spawnPosition = sf::Vector2f(distrX(eng), distrY(eng));
-        distance = std::sqrt(std::pow(spawnPosition.x - playerPosition.x, 2) +
-                             std::pow(spawnPosition.y - playerPosition.y, 2));
-    } while (distance < Ghost::MIN_SPAWN_DISTANCE);
 
-    return spawnPosition;
+/**
+ * Make an id free for the next ghost, timers still holding it see a new generation
+ */
+void GhostStore::releaseId(std::uint32_t id) {
+    ++idGeneration[id];
+    freeIds.push_back(id);
+}
+/**
+ * Index of the ghost with the given id, if it is still the same ghost
+ * @return true if found, false if it was removed since
+ */
+bool GhostStore::findIndex(std::uint32_t id, std::uint32_t generation, std::size_t& index) const {
+    if (id >= idGeneration.size() || idGeneration[id] != generation) {
+        return false;
+    }
+    index = idIndex[id];
+    return true;
 }
 
 
 /**
- * Randomly generate movements for ghosts
+ * Randomly pick a new direction for a ghost
+ * @return the seconds it keeps the direction for
  */
-void Ghost::decideNextMovement() {
-    std::random_device rd;
-    std::mt19937 eng(rd());
+float GhostStore::turn(std::size_t index) {
+    Rng& rng = movementRng[index];
     // Random option of 4 directions
-    std::uniform_real_distribution<> distr(0, 4);
-    // 0.5s - 1.5s movement interval random
-    std::uniform_real_distribution<> timeDistr(0.5, 0.9);
-
-    int dir = static_cast<int>(distr(eng));
+    int dir = rng.uniformInt(0, 3);
     if (dir == 0) { // Up
-        direction = sf::Vector2f(0, -1);
+        dirX[index] = 0;
+        dirY[index] = -1;
     } else if (dir == 1) { // Down
-        direction = sf::Vector2f(0, 1);
+        dirX[index] = 0;
+        dirY[index] = 1;
     } else if (dir == 2) { // Left
-        direction = sf::Vector2f(-1, 0);
+        dirX[index] = -1;
+        dirY[index] = 0;
     } else if (dir == 3) { // Right
-        direction = sf::Vector2f(1, 0);
+        dirX[index] = 1;
+        dirY[index] = 0;
     }
-    movementInterval = timeDistr(eng);
-    movementClock.restart();
+    // 0.5s - 0.9s movement interval random
+    return rng.uniform(0.5f, 0.9f);
 }
 /**
- * Update the movement like the player but for ghosts
+ * Update the movement like the player but for ghosts, one pixel per tick
  */
-void Ghost::updateMovement() {
-    // Decide next movement if the interval has passed
-    if (movementClock.getElapsedTime().asSeconds() >= movementInterval) {
-        decideNextMovement();
+void GhostStore::updateMovement(std::size_t index, const FlowField* field) {
+    prevX[index] = posX[index];
+    prevY[index] = posY[index];
+    float x = dirX[index];
+    float y = dirY[index];
+    // A single lookup in the field, however many ghosts share it
+    if (behavior[index] != GHOST_WANDER && field != nullptr) {
+        FlowField::Step step = behavior[index] == GHOST_CHASE ? field->getToward(posX[index], posY[index])
+                                                              : field->getAway(posX[index], posY[index]);
+        x = FlowField::getStepX(step);
+        y = FlowField::getStepY(step);
     }
-
-    // Move ghost in the decided direction
-    sf::Vector2f newPos = ghost.getPosition() + direction;
-
-    // Apply boundary restrictions
-    newPos.x = std::max(newPos.x, HITBOX);
-    newPos.x = std::min(newPos.x, Game::getSceneWidth() - HITBOX);
-    newPos.y = std::max(newPos.y, HITBOX);
-    newPos.y = std::min(newPos.y, Game::getSceneHeight() - HITBOX);
-
-    ghost.setPosition(newPos);
+    // Move ghost in the decided direction, within the world
+    Ghost::step(posX[index], posY[index], x, y, bounds);
 }
-
 /**
- * Set a custom position for a ghost
- * @test_function
+ * Update the movement of every ghost
  */
-void Ghost::setPosition(const sf::Vector2f& position) {
-    ghost.setPosition(position);
+void GhostStore::updateMovement(const FlowField* field) {
+    updateMovement(0, size(), field);
 }
 /**
- * Get the position of a ghost
+ * Update the movement of the ghosts in [begin, end)
+ */
+void GhostStore::updateMovement(std::size_t begin, std::size_t end, const FlowField* field) {
+    for (std::size_t i = begin; i < end; ++i) {
+        updateMovement(i, field);
+    }
+}
+
+/**
+ * Set a custom position for a ghost
  * @test_function
  */
-sf::Vector2f Ghost::getPosition() {
-    return ghost.getPosition();
-}
\ No newline at end of file
+void GhostStore::setPosition(std::size_t index, const sf::Vector2f& position) {
+    posX[index] = position.x;
+    posY[index] = position.y;
+    prevX[index] = position.x;
+    prevY[index] = position.y;
+}
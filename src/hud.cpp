@@ -0,0 +1,129 @@
+/*
+ * File: hud.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Hud class, texts drawn over the game that only change when their value does
+ */
+
+#include "hud.h"
+#include <cstdio>
+
+/**
+ * HudValue constructor, prefix and suffix must outlive it
+ */
+HudValue::HudValue(const char* prefix, const char* suffix)
+        : prefix(prefix), suffix(suffix), value(0), valid(false) {
+    buffer.reserve(64);
+}
+/**
+ * Show a new number, doing nothing if it's the one already shown
+ * @return true if the text was rebuilt, false otherwise
+ */
+bool HudValue::setValue(int newValue) {
+    if (valid && newValue == value) {
+        return false;
+    }
+    value = newValue;
+    valid = true;
+
+    char digits[16];
+    std::snprintf(digits, sizeof(digits), "%d", value);
+    buffer.assign(prefix);
+    buffer.append(digits);
+    buffer.append(suffix);
+    text.setString(buffer);
+    return true;
+}
+
+
+Hud::Hud() : sceneWidth(0), sceneHeight(0), score("Score: ", " pts"), countdown("Time: ", ""),
+             finalScore("Game Over! Score: ", ""), speedBoosted(false), gameEnded(false) {
+}
+/**
+ * Font, size and placement of every text
+ * @return 0 if successfully initialized, 1 otherwise
+ */
+int Hud::init(const sf::Font& font, float width, float height) {
+    sceneWidth = width;
+    sceneHeight = height;
+
+    sf::Text& scoreText = score.getText();
+    scoreText.setFont(font);
+    scoreText.setCharacterSize(42);
+    scoreText.setFillColor(sf::Color::White);
+    scoreText.setPosition(10.f, 10.f);
+
+    sf::Text& countdownText = countdown.getText();
+    countdownText.setFont(font);
+    countdownText.setCharacterSize(42);
+    countdownText.setFillColor(sf::Color::White);
+    countdownText.setPosition(sceneWidth - 200.f, 10.f);
+
+    sf::Text& finalScoreText = finalScore.getText();
+    finalScoreText.setFont(font);
+    finalScoreText.setCharacterSize(100);
+    finalScoreText.setFillColor(sf::Color::White);
+
+    speedBoostText.setFont(font);
+    speedBoostText.setCharacterSize(80);
+    speedBoostText.setFillColor(sf::Color::Green);
+    speedBoostText.setString("Speed Boost!");
+    // Top middle of the screen
+    sf::FloatRect textRect = speedBoostText.getLocalBounds();
+    speedBoostText.setOrigin(textRect.width / 2, textRect.height / 2);
+    speedBoostText.setPosition(sceneWidth / 2, 20);
+
+    restartText.setFont(font);
+    restartText.setCharacterSize(42);
+    restartText.setFillColor(sf::Color::White);
+    setRestartHint("Enter to play again, hold Backspace to rewind");
+    return 0;
+}
+/**
+ * What the game over screen says about playing again
+ */
+void Hud::setRestartHint(const char* hint) {
+    restartText.setString(hint);
+    // Under the final score
+    sf::FloatRect restartRect = restartText.getLocalBounds();
+    restartText.setOrigin(restartRect.width / 2, restartRect.height / 2);
+    restartText.setPosition(sceneWidth / 2, sceneHeight / 2 + 100);
+}
+
+
+/**
+ * Pick up the values to show, texts are only rebuilt for values that changed
+ */
+void Hud::update(const Snapshot& snapshot) {
+    gameEnded = snapshot.gameEnded;
+    if (gameEnded) {
+        if (finalScore.setValue(snapshot.score)) {
+            // Keep the text centered as its width changes
+            sf::Text& finalScoreText = finalScore.getText();
+            finalScoreText.setOrigin(finalScoreText.getLocalBounds().width / 2,
+                                     finalScoreText.getLocalBounds().height / 2);
+            finalScoreText.setPosition(sf::Vector2f(sceneWidth / 2.0f, sceneHeight / 2.0f - 30.0f));
+        }
+        return;
+    }
+    score.setValue(snapshot.score);
+    countdown.setValue(static_cast<int>(snapshot.timeLeft.asSeconds()));
+    speedBoosted = snapshot.speedBoosted;
+}
+/**
+ * Draw the texts for the current state of the game
+ */
+void Hud::draw(sf::RenderTarget& target) const {
+    if (gameEnded) {
+        // If the game has ended, display the final score text
+        target.draw(finalScore.getText());
+        target.draw(restartText);
+        return;
+    }
+    target.draw(score.getText());
+    // Check if we're within the speed boost period and draw the text if so
+    if (speedBoosted) {
+        target.draw(speedBoostText);
+    }
+    target.draw(countdown.getText());
+}
@@ -0,0 +1,125 @@
+/*
+ * File: input_queue.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: InputQueue class, timestamped direction key changes handed from the
+ * window thread to the simulation thread, and the input-to-display latency they give.
+ */
+
+#include "input_queue.h"
+#include <algorithm>
+
+// Far more changes than anyone presses between two ticks
+const std::size_t InputQueue::CAPACITY = 256;
+const std::size_t InputQueue::LATENCY_SAMPLES = 1024;
+
+/**
+ * InputQueue constructor, the only place its buffers are allocated
+ */
+InputQueue::InputQueue() : changes(CAPACITY), head(0), tail(0), keysDown{0, 0, 0, 0}, held(0), sequence(0),
+                           presentedSequence(0), changeTimes(CAPACITY), latencies(LATENCY_SAMPLES),
+                           latencyCount(0), tickHeld(0), taken(0) {
+}
+
+/**
+ * A key of the direction (one of the INPUT_* bits) went down or up. Several
+ * keys can hold the same direction, it's released with the last of them.
+ */
+void InputQueue::keyChanged(std::uint8_t direction, bool pressed, sf::Time time) {
+    int bit = 0;
+    while (bit < 4 && direction != (1u << bit)) {
+        ++bit;
+    }
+    if (bit == 4) {
+        return;
+    }
+    if (pressed) {
+        ++keysDown[bit];
+    } else if (keysDown[bit] > 0) {
+        --keysDown[bit];
+    }
+    std::uint8_t newHeld = keysDown[bit] > 0 ? held | direction : held & ~direction;
+    // A press is passed on even if another key held the direction, it still counts as a press
+    if (newHeld != held || pressed) {
+        push(newHeld, pressed ? direction : 0, time);
+    }
+}
+/**
+ * Let go of every key, for when the window loses focus and won't hear the releases
+ */
+void InputQueue::releaseAll(sf::Time time) {
+    std::fill(keysDown, keysDown + 4, 0);
+    if (held != 0) {
+        push(0, 0, time);
+    }
+}
+/**
+ * Hand a change to the simulation thread
+ */
+void InputQueue::push(std::uint8_t newHeld, std::uint8_t pressed, sf::Time time) {
+    held = newHeld;
+    std::size_t at = tail.load(std::memory_order_relaxed);
+    if (at - head.load(std::memory_order_acquire) == CAPACITY) {
+        return;
+    }
+    ++sequence;
+    changes[at % CAPACITY] = Change{time, sequence, newHeld, pressed};
+    changeTimes[sequence % CAPACITY] = time;
+    tail.store(at + 1, std::memory_order_release);
+}
+
+/**
+ * Apply every change stamped up to the tick's time
+ * @return the directions held at that time or pressed since the last tick
+ */
+std::uint8_t InputQueue::take(sf::Time tickTime) {
+    std::uint8_t pressed = 0;
+    std::size_t at = head.load(std::memory_order_relaxed);
+    while (at != tail.load(std::memory_order_acquire)) {
+        const Change& change = changes[at % CAPACITY];
+        if (change.time > tickTime) {
+            break;
+        }
+        tickHeld = change.held;
+        pressed |= change.pressed;
+        taken = change.sequence;
+        head.store(++at, std::memory_order_release);
+    }
+    return static_cast<std::uint8_t>(tickHeld | pressed);
+}
+
+/**
+ * Every change up to the sequence was just displayed, keep how long each took
+ */
+void InputQueue::presented(std::uint32_t displayed, sf::Time time) {
+    for (std::uint32_t s = presentedSequence + 1; s <= displayed; ++s) {
+        // Times of changes older than the ring are gone
+        if (sequence - s < CAPACITY) {
+            latencies[latencyCount % LATENCY_SAMPLES] = time - changeTimes[s % CAPACITY];
+            ++latencyCount;
+        }
+    }
+    presentedSequence = std::max(presentedSequence, displayed);
+}
+/**
+ * Median, 95th percentile and worst input-to-display latency of the last changes
+ */
+InputQueue::LatencyReport InputQueue::getLatencyReport() const {
+    return summarize(latencies, latencyCount);
+}
+/**
+ * Median, 95th percentile and max of a ring of samples
+ * @param count samples ever written to the ring, only the ring's size of them are left
+ */
+InputQueue::LatencyReport InputQueue::summarize(const std::vector<sf::Time>& samples, std::size_t count) {
+    LatencyReport report{std::min(count, samples.size()), sf::Time::Zero, sf::Time::Zero, sf::Time::Zero};
+    if (report.samples == 0) {
+        return report;
+    }
+    std::vector<sf::Time> sorted(samples.begin(), samples.begin() + report.samples);
+    std::sort(sorted.begin(), sorted.end());
+    report.median = sorted[sorted.size() / 2];
+    report.p95 = sorted[(sorted.size() * 95) / 100];
+    report.max = sorted.back();
+    return report;
+}
@@ -0,0 +1,147 @@
+/*
+ * File: job_system.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: JobSystem class, splits loops into chunks run by a work stealing thread pool
+ */
+
+#include "job_system.h"
+
+const std::size_t JobSystem::QUEUE_CAPACITY = 1024;
+
+/**
+ * JobSystem constructor, starts the workers
+ */
+JobSystem::JobSystem(unsigned workerCount) : queued(0), stopping(false) {
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.emplace_back(new Queue());
+        queues.back()->jobs.resize(QUEUE_CAPACITY);
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        threads.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+/**
+ * JobSystem destructor, lets the workers finish and joins them
+ */
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+
+/**
+ * Split [0, count) into chunks, deal them out to every queue and help run them
+ */
+void JobSystem::run(std::size_t count, std::size_t chunkSize, void* context, Task task) {
+    if (count == 0) {
+        return;
+    }
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+    std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+    if (threads.empty() || chunks == 1) {
+        task(context, 0, count);
+        return;
+    }
+
+    std::atomic<std::size_t> remaining(chunks);
+    std::size_t self = queues.size() - 1;
+    std::size_t pushed = 0;
+    for (std::size_t c = 0; c < chunks; ++c) {
+        std::size_t begin = c * chunkSize;
+        std::size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        Job job{task, context, begin, end, &remaining};
+        // Every queue full means there's plenty of work already, do this chunk here
+        if (push(c % queues.size(), job)) {
+            ++pushed;
+        } else {
+            task(context, begin, end);
+            remaining.fetch_sub(1);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(pushed);
+    }
+    wake.notify_all();
+
+    while (remaining.load() > 0) {
+        if (!runOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+/**
+ * Run jobs until told to stop, sleeping while there's nothing queued anywhere
+ */
+void JobSystem::workerLoop(std::size_t self) {
+    while (true) {
+        if (runOne(self)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+/**
+ * Run one job, from our own queue if it has any, otherwise stolen from another
+ * @return true if a job was run, false if every queue was empty
+ */
+bool JobSystem::runOne(std::size_t self) {
+    Job job{};
+    bool found = popBack(self, job);
+    for (std::size_t i = 1; !found && i < queues.size(); ++i) {
+        found = popFront((self + i) % queues.size(), job);
+    }
+    if (!found) {
+        return false;
+    }
+    queued.fetch_sub(1);
+    job.task(job.context, job.begin, job.end);
+    job.remaining->fetch_sub(1);
+    return true;
+}
+
+
+bool JobSystem::push(std::size_t queue, const Job& job) {
+    Queue& q = *queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == q.jobs.size()) {
+        return false;
+    }
+    q.jobs[(q.head + q.count) % q.jobs.size()] = job;
+    ++q.count;
+    return true;
+}
+bool JobSystem::popBack(std::size_t queue, Job& job) {
+    Queue& q = *queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == 0) {
+        return false;
+    }
+    --q.count;
+    job = q.jobs[(q.head + q.count) % q.jobs.size()];
+    return true;
+}
+bool JobSystem::popFront(std::size_t queue, Job& job) {
+    Queue& q = *queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == 0) {
+        return false;
+    }
+    job = q.jobs[q.head];
+    q.head = (q.head + 1) % q.jobs.size();
+    --q.count;
+    return true;
+}
@@ -7,8 +7,102 @@
  */
 
 #include "game.h"
+#include "net_client.h"
+#include "replay.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
 
-int main() {
-    Game game;
+/**
+ * Simulate a recorded session again without a window, as fast as it runs
+ * @return 0 if the replay could be read, 1 otherwise
+ */
+static int playReplay(const char* path) {
+    ReplayReader reader;
+    if (reader.open(path) != 0) {
+        std::cerr << "Could not read replay " << path << std::endl;
+        return 1;
+    }
+    SimConfig config;
+    config.worldScale = reader.getWorldScale();
+    GameSim sim(reader.getSeed(), config);
+    sf::Clock clock;
+    std::uint8_t input;
+    while (reader.next(input)) {
+        sim.setInput(input);
+        sim.tick();
+    }
+    float seconds = clock.getElapsedTime().asSeconds();
+
+    std::cout << "seed " << sim.getSeed() << ", " << sim.getTickCount() << " ticks ("
+              << sim.getTime().asSeconds() << " s of play) in " << seconds << " s" << std::endl;
+    std::cout << "score " << sim.getScore() << ", ghosts eaten " << sim.getGhostsEaten()
+              << (sim.isGameEnded() ? "" : ", game not finished") << std::endl;
+    return 0;
+}
+
+/**
+ * Join the game server at HOST:PORT, waiting a few seconds for its answer
+ * @return the client, or nullptr if the server couldn't be joined
+ */
+static std::unique_ptr<NetClient> joinServer(const std::string& hostAndPort) {
+    std::size_t colon = hostAndPort.rfind(':');
+    int port = colon == std::string::npos ? 0 : std::atoi(hostAndPort.c_str() + colon + 1);
+    if (port <= 0 || port > 65535) {
+        std::cerr << "Expected HOST:PORT, got " << hostAndPort << std::endl;
+        return nullptr;
+    }
+    sf::IpAddress address(hostAndPort.substr(0, colon));
+    std::unique_ptr<NetClient> client(new NetClient());
+    if (client->join(address, static_cast<unsigned short>(port)) != 0 ||
+        client->waitForWelcome(sf::seconds(5)) != 0) {
+        std::cerr << (client->isRefused() ? "Server is full: " : "No answer from server ") << hostAndPort
+                  << std::endl;
+        return nullptr;
+    }
+    std::cout << "Joined " << hostAndPort << " as player " << client->getPlayerIndex() + 1 << " of "
+              << client->getConfig().players << std::endl;
+    return client;
+}
+
+int main(int argc, char* argv[]) {
+    const char* recordPath = nullptr;
+    const char* serverAddress = nullptr;
+    SimConfig config;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            return playReplay(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--connect") == 0 && i + 1 < argc) {
+            serverAddress = argv[++i];
+        } else if (std::strcmp(argv[i], "--world-scale") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) >= 1 &&
+                   std::atoi(argv[i + 1]) <= 255) {
+            config.worldScale = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--world-scale N] [--record FILE | --replay FILE | --connect HOST:PORT]"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    if (serverAddress != nullptr) {
+        // The server's world, not ours
+        std::unique_ptr<NetClient> client = joinServer(serverAddress);
+        if (!client) {
+            return 1;
+        }
+        Game game(client->getConfig());
+        game.playOnServer(std::move(client));
+        return game.run();
+    }
+
+    Game game(config);
+    if (recordPath != nullptr && game.startRecording(recordPath) != 0) {
+        std::cerr << "Could not write replay " << recordPath << std::endl;
+        return 1;
+    }
     return game.run();
-}
\ No newline at end of file
+}
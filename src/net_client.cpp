@@ -0,0 +1,307 @@
+/*
+ * File: net_client.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: NetClient class, joins a game server, decodes its states and
+ * predicts the local player from the inputs it hasn't applied yet
+ */
+
+#include "net_client.h"
+
+// Matches the server's history, a second at 120 Hz would be plenty as well
+const std::size_t NetClient::HISTORY = 64;
+
+namespace {
+
+sf::Vector2f dequantize(const NetState::Player& player) {
+    return {NetProtocol::dequantize(player.x), NetProtocol::dequantize(player.y)};
+}
+
+sf::Vector2f dequantize(const NetState::Entity& entity) {
+    return {NetProtocol::dequantize(entity.x), NetProtocol::dequantize(entity.y)};
+}
+
+} // namespace
+
+/**
+ * NetClient constructor, the states are sized once the server says how big its game is
+ */
+NetClient::NetClient()
+        : serverPort(0), connected(false), refused(false), playerIndex(0), sequence(0), inputs(HISTORY),
+          states(HISTORY), latest(0), received(false), shownValid(false), buffer(NetProtocol::MAX_DATAGRAM),
+          stateBytes(0), statesReceived(0) {
+    message.reserve(64);
+}
+
+NetClient::~NetClient() {
+    leave();
+}
+
+/**
+ * Open a socket on any port and send the server a join
+ * @return 0 if the join could be sent, 1 otherwise
+ */
+int NetClient::join(const sf::IpAddress& address, unsigned short port) {
+    if (socket.getLocalPort() == 0 && socket.bind(sf::Socket::AnyPort) != sf::Socket::Done) {
+        return 1;
+    }
+    socket.setBlocking(false);
+    serverAddress = address;
+    serverPort = port;
+    std::uint8_t join = NetProtocol::JOIN;
+    return socket.send(&join, 1, serverAddress, serverPort) == sf::Socket::Done ? 0 : 1;
+}
+/**
+ * Block until the server welcomed us and sent a first state, joining again
+ * every quarter second in case a datagram got lost
+ * @return 0 once playing, 1 if the server is full or didn't answer in time
+ */
+int NetClient::waitForWelcome(sf::Time timeout) {
+    sf::Clock clock;
+    sf::Time nextJoin = sf::milliseconds(250);
+    while (clock.getElapsedTime() < timeout) {
+        receive();
+        if (refused) {
+            return 1;
+        }
+        if (connected && received) {
+            return 0;
+        }
+        if (!connected && clock.getElapsedTime() >= nextJoin) {
+            join(serverAddress, serverPort);
+            nextJoin += sf::milliseconds(250);
+        }
+        sf::sleep(sf::milliseconds(5));
+    }
+    return 1;
+}
+/**
+ * Free our slot on the server, which would also free it after a few quiet seconds
+ */
+void NetClient::leave() {
+    if (connected) {
+        std::uint8_t leave = NetProtocol::LEAVE;
+        socket.send(&leave, 1, serverAddress, serverPort);
+        connected = false;
+    }
+}
+
+/**
+ * Read every datagram the server sent since the last call
+ */
+void NetClient::receive() {
+    std::size_t size = 0;
+    sf::IpAddress address;
+    unsigned short port = 0;
+    while (socket.receive(buffer.data(), buffer.size(), size, address, port) == sf::Socket::Done) {
+        if (address != serverAddress || port != serverPort) {
+            continue;
+        }
+        ByteReader reader(buffer.data(), size);
+        std::uint8_t type = reader.getByte();
+        if (type == NetProtocol::WELCOME && !connected) {
+            handleWelcome(reader);
+        } else if (type == NetProtocol::FULL && !connected) {
+            refused = true;
+        } else if (type == NetProtocol::STATE && connected) {
+            handleState(reader, size);
+        }
+    }
+}
+/**
+ * Our player, and the shape of the server's game
+ */
+void NetClient::handleWelcome(ByteReader& reader) {
+    std::uint64_t player = reader.getVarint();
+    std::uint64_t players = reader.getVarint();
+    std::uint64_t worldScale = reader.getVarint();
+    float baseSpeed = reader.getFloat();
+    float boostedSpeed = reader.getFloat();
+    float totalSeconds = reader.getFloat();
+    if (!reader.ok() || player >= players || players > 0xFF || worldScale < 1 || worldScale > 255) {
+        return;
+    }
+    playerIndex = static_cast<std::size_t>(player);
+    config.players = static_cast<int>(players);
+    config.worldScale = static_cast<int>(worldScale);
+    config.basePlayerSpeed = baseSpeed;
+    config.boostedPlayerSpeed = boostedSpeed;
+    config.totalTime = sf::seconds(totalSeconds);
+    worldSize = GameSim::getSceneSize() * static_cast<float>(config.worldScale);
+    for (NetState& state : states) {
+        state.reserve(config);
+    }
+    shown.reserve(config);
+    connected = true;
+}
+/**
+ * Decode a state against the baseline it names, keeping it if it's the
+ * newest yet. States that arrive late, or whose baseline we no longer have,
+ * are dropped; the next one will do.
+ */
+void NetClient::handleState(ByteReader& reader, std::size_t size) {
+    std::uint8_t round = reader.getByte();
+    auto tick = static_cast<std::uint32_t>(reader.getVarint());
+    auto baselineTick = static_cast<std::uint32_t>(reader.getVarint());
+    if (!reader.ok() || tick == 0) {
+        return;
+    }
+    if (received) {
+        const NetState& newest = states[latest];
+        // a round is newer if it's less than half the round numbers ahead, they wrap
+        auto roundsAhead = static_cast<std::uint8_t>(round - newest.round);
+        if (roundsAhead >= 128 || (roundsAhead == 0 && tick <= newest.tick)) {
+            return;
+        }
+    }
+    const NetState* baseline = nullptr;
+    if (baselineTick != 0) {
+        const NetState& candidate = states[baselineTick % HISTORY];
+        if (baselineTick >= tick || tick - baselineTick >= HISTORY || candidate.tick != baselineTick ||
+            candidate.round != round) {
+            return;
+        }
+        baseline = &candidate;
+    }
+
+    NetState& state = states[tick % HISTORY];
+    if (!state.decode(baseline, reader)) {
+        // half decoded, it's no good as a baseline
+        state.tick = 0;
+        return;
+    }
+    state.round = round;
+    state.tick = tick;
+    latest = tick % HISTORY;
+    if (!received) {
+        received = true;
+        predict();
+        previousPredicted = predicted;
+    }
+    stateBytes += size;
+    ++statesReceived;
+}
+
+/**
+ * Numbered, with the newest state received so the server codes the next ones against it
+ */
+void NetClient::sendInput(std::uint8_t input, sf::Time now) {
+    ++sequence;
+    inputs[sequence % HISTORY] = SentInput{input, now};
+    ByteWriter writer(message);
+    writer.putByte(NetProtocol::INPUT);
+    writer.putByte(received ? states[latest].round : 0);
+    writer.putVarint(received ? states[latest].tick : 0);
+    writer.putVarint(sequence);
+    writer.putByte(input);
+    socket.send(message.data(), message.size(), serverAddress, serverPort);
+}
+/**
+ * The server's position of our player, moved on by every input it hadn't applied yet
+ */
+void NetClient::predict() {
+    const NetState& state = states[latest];
+    if (playerIndex >= state.players.size()) {
+        return;
+    }
+    const NetState::Player& player = state.players[playerIndex];
+    predicted = dequantize(player);
+    if (state.gameEnded) {
+        return;
+    }
+    float speed = player.boosted ? config.boostedPlayerSpeed : config.basePlayerSpeed;
+    // Inputs older than the history are gone, the server hearing none of them for that long means trouble anyway
+    std::uint32_t first = player.inputSequence + 1;
+    if (sequence - player.inputSequence > HISTORY) {
+        first = sequence - static_cast<std::uint32_t>(HISTORY) + 1;
+    }
+    for (std::uint32_t s = first; s <= sequence && s != 0; ++s) {
+        predicted = GameSim::movePlayer(predicted, inputs[s % HISTORY].input, speed, worldSize);
+    }
+}
+/**
+ * One tick of the client, in the order that gets the input to the server soonest
+ */
+void NetClient::update(std::uint8_t input, sf::Time now) {
+    receive();
+    if (!connected) {
+        return;
+    }
+    sendInput(input, now);
+    if (received) {
+        previousPredicted = predicted;
+        predict();
+    }
+}
+
+sf::Time NetClient::getAckedInputTime() const {
+    if (!received || playerIndex >= states[latest].players.size()) {
+        return sf::Time::Zero;
+    }
+    std::uint32_t acked = states[latest].players[playerIndex].inputSequence;
+    if (acked == 0 || sequence - acked >= HISTORY) {
+        return sf::Time::Zero;
+    }
+    return inputs[acked % HISTORY].time;
+}
+
+double NetClient::getBytesPerTick() const {
+    return statesReceived == 0 ? 0.0 : static_cast<double>(stateBytes) / static_cast<double>(statesReceived);
+}
+
+/**
+ * Overwrite the snapshot with the newest state. Other entities move from
+ * where the last capture showed them, so they're drawn as smoothly as the
+ * states come in.
+ */
+void NetClient::capture(Snapshot& snapshot, sf::Time tickTime) {
+    const NetState& state = states[latest];
+    const NetState* before = shownValid && shown.round == state.round ? &shown : nullptr;
+    snapshot.tick = state.tick;
+    snapshot.time = tickTime;
+    snapshot.previousPlayerPosition = previousPredicted;
+    snapshot.playerPosition = predicted;
+
+    snapshot.rivals.clear();
+    for (std::size_t i = 0; i < state.players.size(); ++i) {
+        if (i == playerIndex) {
+            continue;
+        }
+        sf::Vector2f position = dequantize(state.players[i]);
+        sf::Vector2f previous = before && i < before->players.size() ? dequantize(before->players[i]) : position;
+        snapshot.rivals.push_back(Snapshot::Sprite{previous, position, static_cast<std::uint8_t>(i)});
+    }
+    copyEntities(state.ghosts, before ? &before->ghosts : nullptr, snapshot.ghosts);
+    copyEntities(state.fruits, before ? &before->fruits : nullptr, snapshot.fruits);
+
+    const NetState::Player* own = playerIndex < state.players.size() ? &state.players[playerIndex] : nullptr;
+    snapshot.score = own ? own->score : 0;
+    snapshot.timeLeft = sf::milliseconds(static_cast<std::int32_t>(state.timeLeftMs));
+    snapshot.speedBoosted = own && own->boosted != 0;
+    snapshot.gameEnded = state.gameEnded;
+    snapshot.ackedInputTime = getAckedInputTime();
+
+    shown = state;
+    shownValid = received;
+}
+/**
+ * Both lists are sorted by id, so each entity finds where it was in one pass
+ */
+void NetClient::copyEntities(const std::vector<NetState::Entity>& current,
+                             const std::vector<NetState::Entity>* before, std::vector<Snapshot::Sprite>& sprites) {
+    sprites.clear();
+    std::size_t j = 0;
+    for (const NetState::Entity& entity : current) {
+        sf::Vector2f position = dequantize(entity);
+        sf::Vector2f previous = position;
+        if (before != nullptr) {
+            while (j < before->size() && (*before)[j].id < entity.id) {
+                ++j;
+            }
+            if (j < before->size() && (*before)[j].id == entity.id && (*before)[j].look == entity.look) {
+                previous = dequantize((*before)[j]);
+            }
+        }
+        sprites.push_back(Snapshot::Sprite{previous, position, entity.look});
+    }
+}
@@ -0,0 +1,290 @@
+/*
+ * File: net_protocol.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Varint coding, world state capture and the delta coding of
+ * states between server and clients
+ */
+
+#include "net_protocol.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Quarter pixels, so a ghost's 1 pixel step or a player's 5 pixels fit in a one byte delta
+const float NetProtocol::POSITION_SCALE = 4.0f;
+// What a UDP datagram can hold. Anything over about 1400 bytes gets split by IP
+// on the way, which only full states of very crowded games come near.
+const std::size_t NetProtocol::MAX_DATAGRAM = 65507;
+
+namespace {
+
+// Entity entries start with a varint of (id gap << 2 | what)
+enum EntityChange : std::uint8_t { ENTITY_MOVED, ENTITY_FULL, ENTITY_REMOVED, ENTITY_END };
+
+bool byId(const NetState::Entity& a, const NetState::Entity& b) {
+    return a.id < b.id;
+}
+
+} // namespace
+
+std::int32_t NetProtocol::quantize(float value) {
+    return static_cast<std::int32_t>(std::lround(value * POSITION_SCALE));
+}
+
+float NetProtocol::dequantize(std::int32_t value) {
+    return static_cast<float>(value) / POSITION_SCALE;
+}
+
+/**
+ * Seven bits per byte, lowest first, the top bit set on every byte but the last
+ */
+void ByteWriter::putVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * Zigzag coded, so small values of either sign stay short
+ */
+void ByteWriter::putSigned(std::int64_t value) {
+    putVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+}
+
+void ByteWriter::putFloat(float value) {
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int shift = 0; shift < 32; shift += 8) {
+        bytes.push_back(static_cast<std::uint8_t>(bits >> shift));
+    }
+}
+
+std::uint8_t ByteReader::getByte() {
+    if (offset >= size) {
+        failed = true;
+        return 0;
+    }
+    return data[offset++];
+}
+
+std::uint64_t ByteReader::getVarint() {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        std::uint8_t byte = getByte();
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return failed ? 0 : value;
+        }
+    }
+    // more than ten bytes is never a varint we wrote
+    failed = true;
+    return 0;
+}
+
+std::int64_t ByteReader::getSigned() {
+    std::uint64_t value = getVarint();
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+float ByteReader::getFloat() {
+    std::uint32_t bits = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        bits |= static_cast<std::uint32_t>(getByte()) << shift;
+    }
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Reserve room for every player, ghost and fruit a game of the config can hold
+ */
+void NetState::reserve(const SimConfig& config) {
+    players.reserve(static_cast<std::size_t>(config.players));
+    ghosts.reserve(static_cast<std::size_t>(config.maxGhosts));
+    fruits.reserve(static_cast<std::size_t>(config.maxFruits));
+}
+/**
+ * Overwrite the state with the simulation's current tick, quantized
+ */
+void NetState::capture(const GameSim& sim, std::uint8_t newRound, const std::uint32_t* inputSequences) {
+    round = newRound;
+    tick = sim.getTickCount();
+    timeLeftMs = static_cast<std::uint32_t>(std::max(sim.getTimeLeft().asMilliseconds(), 0));
+    gameEnded = sim.isGameEnded();
+
+    players.clear();
+    for (std::size_t i = 0; i < sim.getPlayerCount(); ++i) {
+        const sf::Vector2f& position = sim.getPlayerPosition(i);
+        players.push_back(Player{NetProtocol::quantize(position.x), NetProtocol::quantize(position.y),
+                                 sim.getScore(i), static_cast<std::uint8_t>(sim.isSpeedBoosted(i)),
+                                 inputSequences[i]});
+    }
+
+    // The store moves ghosts around as others are removed, ids are what stays put
+    const GhostStore& store = sim.getGhosts();
+    ghosts.clear();
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        sf::Vector2f position = store.getPosition(i);
+        ghosts.push_back(Entity{store.getId(i), NetProtocol::quantize(position.x), NetProtocol::quantize(position.y),
+                                static_cast<std::uint8_t>(store.getColor(i))});
+    }
+    std::sort(ghosts.begin(), ghosts.end(), byId);
+
+    // already in slot order
+    fruits.clear();
+    const Pool<Fruit>& pool = sim.getFruits();
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+        const Fruit& fruit = *it;
+        fruits.push_back(Entity{it.getSlot(), NetProtocol::quantize(fruit.getPosition().x),
+                                NetProtocol::quantize(fruit.getPosition().y),
+                                static_cast<std::uint8_t>(fruit.getKind())});
+    }
+}
+/**
+ * Write the state as its difference from the baseline, or from an empty
+ * state without one. Round and tick are the message's, not written here.
+ */
+void NetState::encode(const NetState* baseline, ByteWriter& writer) const {
+    writer.putSigned(static_cast<std::int64_t>(timeLeftMs) - (baseline ? baseline->timeLeftMs : 0));
+    writer.putByte(static_cast<std::uint8_t>(gameEnded));
+
+    writer.putVarint(players.size());
+    const Player none{0, 0, 0, 0, 0};
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        const Player& old = baseline && i < baseline->players.size() ? baseline->players[i] : none;
+        const Player& player = players[i];
+        writer.putSigned(static_cast<std::int64_t>(player.x) - old.x);
+        writer.putSigned(static_cast<std::int64_t>(player.y) - old.y);
+        writer.putSigned(static_cast<std::int64_t>(player.score) - old.score);
+        writer.putByte(player.boosted);
+        writer.putSigned(static_cast<std::int64_t>(player.inputSequence) - old.inputSequence);
+    }
+
+    encodeEntities(ghosts, baseline ? &baseline->ghosts : nullptr, writer);
+    encodeEntities(fruits, baseline ? &baseline->fruits : nullptr, writer);
+}
+/**
+ * Read a state written by encode() against the same baseline
+ * @return true if the bytes held a whole state
+ */
+bool NetState::decode(const NetState* baseline, ByteReader& reader) {
+    timeLeftMs = static_cast<std::uint32_t>((baseline ? baseline->timeLeftMs : 0) + reader.getSigned());
+    gameEnded = reader.getByte() != 0;
+
+    std::uint64_t playerCount = reader.getVarint();
+    // a player count this big can only be a broken message
+    if (!reader.ok() || playerCount > 0xFF) {
+        return false;
+    }
+    players.resize(static_cast<std::size_t>(playerCount));
+    const Player none{0, 0, 0, 0, 0};
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        const Player& old = baseline && i < baseline->players.size() ? baseline->players[i] : none;
+        Player& player = players[i];
+        player.x = static_cast<std::int32_t>(old.x + reader.getSigned());
+        player.y = static_cast<std::int32_t>(old.y + reader.getSigned());
+        player.score = static_cast<std::int32_t>(old.score + reader.getSigned());
+        player.boosted = reader.getByte();
+        player.inputSequence = static_cast<std::uint32_t>(old.inputSequence + reader.getSigned());
+    }
+
+    return decodeEntities(baseline ? &baseline->ghosts : nullptr, reader, ghosts) &&
+           decodeEntities(baseline ? &baseline->fruits : nullptr, reader, fruits) && reader.ok();
+}
+
+/**
+ * One pass over both id sorted lists. Entities the same as in the baseline
+ * are left out, the rest each get an entry: a move for the ones that only
+ * moved, everything for new or changed ones, a removal for the ones gone.
+ */
+void NetState::encodeEntities(const std::vector<Entity>& current, const std::vector<Entity>* baseline,
+                              ByteWriter& writer) {
+    static const std::vector<Entity> emptyList;
+    const std::vector<Entity>& old = baseline ? *baseline : emptyList;
+    // ids are written as the gap from the id after the last entry's
+    std::uint32_t nextId = 0;
+    auto putEntry = [&](std::uint32_t id, EntityChange change) {
+        writer.putVarint((static_cast<std::uint64_t>(id - nextId) << 2) | change);
+        nextId = id + 1;
+    };
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < current.size() || j < old.size()) {
+        if (j == old.size() || (i < current.size() && current[i].id < old[j].id)) {
+            const Entity& added = current[i++];
+            putEntry(added.id, ENTITY_FULL);
+            writer.putSigned(added.x);
+            writer.putSigned(added.y);
+            writer.putByte(added.look);
+        } else if (i == current.size() || old[j].id < current[i].id) {
+            putEntry(old[j++].id, ENTITY_REMOVED);
+        } else {
+            const Entity& entity = current[i++];
+            const Entity& before = old[j++];
+            if (entity.look != before.look) {
+                // a new entity that took the id of one removed since the baseline
+                putEntry(entity.id, ENTITY_FULL);
+                writer.putSigned(entity.x);
+                writer.putSigned(entity.y);
+                writer.putByte(entity.look);
+            } else if (entity.x != before.x || entity.y != before.y) {
+                putEntry(entity.id, ENTITY_MOVED);
+                writer.putSigned(static_cast<std::int64_t>(entity.x) - before.x);
+                writer.putSigned(static_cast<std::int64_t>(entity.y) - before.y);
+            }
+        }
+    }
+    writer.putVarint(ENTITY_END);
+}
+/**
+ * Baseline entities without an entry are copied over unchanged
+ */
+bool NetState::decodeEntities(const std::vector<Entity>* baseline, ByteReader& reader,
+                              std::vector<Entity>& decoded) {
+    static const std::vector<Entity> emptyList;
+    const std::vector<Entity>& old = baseline ? *baseline : emptyList;
+    decoded.clear();
+    std::size_t j = 0;
+    std::uint64_t nextId = 0;
+    while (true) {
+        std::uint64_t header = reader.getVarint();
+        auto change = static_cast<EntityChange>(header & 3);
+        if (!reader.ok() || change == ENTITY_END) {
+            break;
+        }
+        std::uint64_t id = nextId + (header >> 2);
+        if (id > 0xFFFFFFFFu) {
+            return false;
+        }
+        nextId = id + 1;
+        while (j < old.size() && old[j].id < id) {
+            decoded.push_back(old[j++]);
+        }
+        bool inBaseline = j < old.size() && old[j].id == id;
+        if (change == ENTITY_FULL) {
+            auto x = static_cast<std::int32_t>(reader.getSigned());
+            auto y = static_cast<std::int32_t>(reader.getSigned());
+            decoded.push_back(Entity{static_cast<std::uint32_t>(id), x, y, reader.getByte()});
+        } else if (inBaseline && change == ENTITY_MOVED) {
+            Entity moved = old[j];
+            moved.x = static_cast<std::int32_t>(moved.x + reader.getSigned());
+            moved.y = static_cast<std::int32_t>(moved.y + reader.getSigned());
+            decoded.push_back(moved);
+        } else if (!inBaseline) {
+            // moving or removing something the baseline doesn't have
+            return false;
+        }
+        if (inBaseline) {
+            ++j;
+        }
+    }
+    while (j < old.size()) {
+        decoded.push_back(old[j++]);
+    }
+    return reader.ok();
+}
@@ -0,0 +1,221 @@
+/*
+ * File: net_server.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: NetServer class, ticks the authoritative game and keeps every
+ * client's player and view of the world in step with it
+ */
+
+#include "net_server.h"
+#include <algorithm>
+
+// Over half a second at 120 Hz, far more than a client's state can be in flight
+const std::size_t NetServer::HISTORY = 64;
+// 5 seconds at 120 Hz
+const std::uint32_t NetServer::CLIENT_TIMEOUT_TICKS = 600;
+
+/**
+ * NetServer constructor, every buffer is sized here for the config's game
+ */
+NetServer::NetServer(std::uint64_t seed, const SimConfig& config)
+        : sim(seed, config), round(0), clients(static_cast<std::size_t>(std::max(config.players, 1))),
+          sequences(clients.size(), 0), history(HISTORY), ticksRun(0), received(NetProtocol::MAX_DATAGRAM),
+          stateBytes(0), statesSent(0) {
+    sim.save(startState);
+    for (Client& client : clients) {
+        client = Client{false, sf::IpAddress(), 0, INPUT_NONE, 0, 0, 0};
+    }
+    for (NetState& state : history) {
+        state.reserve(sim.getConfig());
+    }
+    message.reserve(NetProtocol::MAX_DATAGRAM);
+}
+
+/**
+ * Open the server's socket
+ * @return 0 if the port could be bound, 1 otherwise
+ */
+int NetServer::start(unsigned short port) {
+    if (socket.bind(port) != sf::Socket::Done) {
+        return 1;
+    }
+    socket.setBlocking(false);
+    return 0;
+}
+
+std::size_t NetServer::getClientCount() const {
+    std::size_t count = 0;
+    for (const Client& client : clients) {
+        count += client.connected ? 1 : 0;
+    }
+    return count;
+}
+
+double NetServer::getBytesPerTick() const {
+    return statesSent == 0 ? 0.0 : static_cast<double>(stateBytes) / static_cast<double>(statesSent);
+}
+
+/**
+ * Read every datagram that arrived since the last call. Anything that isn't
+ * a well formed message from a known client (or a join) is ignored.
+ */
+void NetServer::receive() {
+    std::size_t size = 0;
+    sf::IpAddress address;
+    unsigned short port = 0;
+    while (socket.receive(received.data(), received.size(), size, address, port) == sf::Socket::Done) {
+        ByteReader reader(received.data(), size);
+        std::uint8_t type = reader.getByte();
+        if (type == NetProtocol::JOIN) {
+            handleJoin(address, port);
+            continue;
+        }
+        Client* client = findClient(address, port);
+        if (client == nullptr) {
+            continue;
+        }
+        client->lastHeard = ticksRun;
+        if (type == NetProtocol::INPUT) {
+            handleInput(*client, reader);
+        } else if (type == NetProtocol::LEAVE) {
+            client->connected = false;
+            client->input = INPUT_NONE;
+        }
+    }
+}
+/**
+ * A client that joins again (its welcome got lost) keeps its slot,
+ * a new one gets the first free slot if there is one
+ */
+void NetServer::handleJoin(const sf::IpAddress& address, unsigned short port) {
+    Client* client = findClient(address, port);
+    if (client == nullptr) {
+        for (Client& slot : clients) {
+            if (!slot.connected) {
+                slot = Client{true, address, port, INPUT_NONE, 0, 0, ticksRun};
+                client = &slot;
+                break;
+            }
+        }
+    }
+    if (client == nullptr) {
+        message.clear();
+        message.push_back(NetProtocol::FULL);
+        socket.send(message.data(), message.size(), address, port);
+        return;
+    }
+    client->lastHeard = ticksRun;
+    sendWelcome(static_cast<std::size_t>(client - clients.data()));
+}
+/**
+ * The input is held from the next tick on, until a newer one comes. Only the
+ * newest input matters, so a lost one is made up for by the next.
+ */
+void NetServer::handleInput(Client& client, ByteReader& reader) {
+    std::uint8_t inputRound = reader.getByte();
+    auto ackTick = static_cast<std::uint32_t>(reader.getVarint());
+    auto sequence = static_cast<std::uint32_t>(reader.getVarint());
+    std::uint8_t input = reader.getByte();
+    if (!reader.ok()) {
+        return;
+    }
+    if (sequence > client.sequence) {
+        client.sequence = sequence;
+        client.input = input & (INPUT_UP | INPUT_DOWN | INPUT_LEFT | INPUT_RIGHT);
+    }
+    if (inputRound == round && ackTick > client.ackTick && ackTick <= sim.getTickCount()) {
+        client.ackTick = ackTick;
+    }
+}
+
+NetServer::Client* NetServer::findClient(const sf::IpAddress& address, unsigned short port) {
+    for (Client& client : clients) {
+        if (client.connected && client.address == address && client.port == port) {
+            return &client;
+        }
+    }
+    return nullptr;
+}
+/**
+ * Everything a client needs to know before the first state: its player and
+ * what the world it predicts its player in looks like
+ */
+void NetServer::sendWelcome(std::size_t player) {
+    const SimConfig& config = sim.getConfig();
+    ByteWriter writer(message);
+    writer.putByte(NetProtocol::WELCOME);
+    writer.putVarint(player);
+    writer.putVarint(clients.size());
+    writer.putVarint(static_cast<std::uint64_t>(config.worldScale));
+    writer.putFloat(config.basePlayerSpeed);
+    writer.putFloat(config.boostedPlayerSpeed);
+    writer.putFloat(config.totalTime.asSeconds());
+    socket.send(message.data(), message.size(), clients[player].address, clients[player].port);
+}
+
+/**
+ * Play a tick and send its state to every client
+ */
+void NetServer::tick() {
+    ++ticksRun;
+    for (std::size_t i = 0; i < clients.size(); ++i) {
+        Client& client = clients[i];
+        if (client.connected && ticksRun - client.lastHeard > CLIENT_TIMEOUT_TICKS) {
+            client.connected = false;
+            client.input = INPUT_NONE;
+        }
+        sim.setInput(client.input, i);
+        sequences[i] = client.sequence;
+    }
+    sim.tick();
+
+    NetState& state = history[sim.getTickCount() % HISTORY];
+    state.capture(sim, round, sequences.data());
+    for (Client& client : clients) {
+        if (client.connected) {
+            sendState(client, state);
+        }
+    }
+}
+/**
+ * Against the newest state the client has, if it's still in the history
+ */
+void NetServer::sendState(Client& client, const NetState& state) {
+    const NetState* baseline = nullptr;
+    if (client.ackTick != 0 && state.tick - client.ackTick < HISTORY) {
+        const NetState& acked = history[client.ackTick % HISTORY];
+        if (acked.tick == client.ackTick && acked.round == round) {
+            baseline = &acked;
+        }
+    }
+
+    ByteWriter writer(message);
+    writer.putByte(NetProtocol::STATE);
+    writer.putByte(round);
+    writer.putVarint(state.tick);
+    writer.putVarint(baseline ? baseline->tick : 0);
+    state.encode(baseline, writer);
+    if (message.size() > NetProtocol::MAX_DATAGRAM) {
+        return;
+    }
+    if (socket.send(message.data(), message.size(), client.address, client.port) == sf::Socket::Done) {
+        stateBytes += message.size();
+        ++statesSent;
+    }
+}
+
+/**
+ * Restore the game's start with a new seed. The round changes so that no
+ * state of the old game is ever used as a baseline for the new one.
+ */
+void NetServer::restart(std::uint64_t newSeed) {
+    sim.restore(startState);
+    sim.reseed(newSeed);
+    ++round;
+    for (Client& client : clients) {
+        client.ackTick = 0;
+    }
+    for (NetState& state : history) {
+        state.tick = 0;
+    }
+}
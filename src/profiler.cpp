@@ -0,0 +1,133 @@
+/*
+ * File: profiler.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Profiler class, scoped timing zones kept in a fixed ring buffer,
+ * tallied per frame and dumped as Chrome trace JSON.
+ */
+
+#include "profiler.h"
+#include <cstdio>
+
+// About a second of zones at a few hundred zones per frame
+const std::size_t Profiler::EVENT_CAPACITY = 1u << 16u;
+const std::size_t Profiler::MAX_ZONES = 32;
+const std::size_t Profiler::FRAME_HISTORY = 240;
+
+/**
+ * Profiler constructor, the only place its buffers are allocated
+ */
+Profiler::Profiler() : origin(Clock::now()), events(EVENT_CAPACITY), written(0), frameStartEvent(0),
+                       frameStartTime(0), frameTimes(FRAME_HISTORY, 0), frameCount(0),
+                       frameStartAllocations(AllocTracker::getTotal()), frameAllocations{0, 0, 0} {
+    frameZones.reserve(MAX_ZONES);
+}
+/**
+ * Profiler shared by the whole program
+ */
+Profiler& Profiler::get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+/**
+ * Small number naming the calling thread in traces, 0 being the first thread to record
+ */
+std::uint32_t Profiler::threadIndex() {
+    static std::atomic<std::uint32_t> threads(0);
+    thread_local std::uint32_t index = threads.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+/**
+ * Keep one finished zone, overwriting the oldest one when the ring is full
+ */
+void Profiler::record(const char* name, std::int64_t start, std::int64_t end, std::uint64_t allocations,
+                      std::uint64_t bytes) {
+    std::uint64_t slot = written.fetch_add(1, std::memory_order_relaxed);
+    events[slot % EVENT_CAPACITY] = Event{name, start, end, threadIndex(), static_cast<std::uint32_t>(allocations),
+                                          static_cast<std::uint32_t>(bytes)};
+}
+
+/**
+ * Tally the zones recorded since the last frame ended and keep the frame's length
+ */
+void Profiler::endFrame() {
+    std::int64_t time = now();
+    std::uint64_t end = written.load(std::memory_order_acquire);
+    // Zones that were overwritten before being tallied are lost for this frame
+    std::uint64_t begin = end - frameStartEvent > EVENT_CAPACITY ? end - EVENT_CAPACITY : frameStartEvent;
+
+    frameZones.clear();
+    for (std::uint64_t i = begin; i < end; ++i) {
+        const Event& event = events[i % EVENT_CAPACITY];
+        std::size_t zone = 0;
+        while (zone < frameZones.size() && frameZones[zone].name != event.name) {
+            ++zone;
+        }
+        if (zone == frameZones.size()) {
+            if (frameZones.size() == MAX_ZONES) {
+                continue;
+            }
+            frameZones.push_back(ZoneStats{event.name, 0, 0, 0, 0});
+        }
+        frameZones[zone].total += event.end - event.start;
+        ++frameZones[zone].calls;
+        frameZones[zone].allocations += event.allocations;
+        frameZones[zone].bytes += event.bytes;
+    }
+
+    AllocTracker::Counts allocations = AllocTracker::getTotal();
+    frameAllocations = AllocTracker::Counts{allocations.allocations - frameStartAllocations.allocations,
+                                            allocations.bytes - frameStartAllocations.bytes,
+                                            allocations.frees - frameStartAllocations.frees};
+    frameStartAllocations = allocations;
+
+    frameTimes[frameCount % FRAME_HISTORY] = time - frameStartTime;
+    ++frameCount;
+    frameStartEvent = end;
+    frameStartTime = time;
+}
+/**
+ * Forget every zone and frame
+ */
+void Profiler::clear() {
+    written.store(0, std::memory_order_relaxed);
+    frameStartEvent = 0;
+    frameStartTime = now();
+    frameZones.clear();
+    frameCount = 0;
+}
+/**
+ * Length of one of the last frames, 0 being the oldest one kept
+ */
+std::int64_t Profiler::getFrameTime(std::size_t index) const {
+    std::size_t first = frameCount < FRAME_HISTORY ? 0 : frameCount % FRAME_HISTORY;
+    return frameTimes[(first + index) % FRAME_HISTORY];
+}
+
+
+/**
+ * Write every zone still in the ring as complete events of the Chrome trace
+ * format, which chrome://tracing and Perfetto open as is
+ * @return 0 if the file was written, 1 otherwise
+ */
+int Profiler::dumpChromeTrace(const std::string& path) const {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return 1;
+    }
+    std::uint64_t end = written.load(std::memory_order_acquire);
+    std::uint64_t begin = end > EVENT_CAPACITY ? end - EVENT_CAPACITY : 0;
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    for (std::uint64_t i = begin; i < end; ++i) {
+        const Event& event = events[i % EVENT_CAPACITY];
+        // Zone names are identifiers in the code, nothing in them needs escaping
+        std::fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                           "\"args\":{\"allocations\":%u,\"bytes\":%u}}",
+                     i == begin ? "" : ",", event.name, event.thread, event.start / 1000.0,
+                     (event.end - event.start) / 1000.0, event.allocations, event.bytes);
+    }
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+/*
+ * File: profiler_overlay.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ProfilerOverlay class, frame time graph and per zone times drawn over the game.
+ */
+
+#include "profiler_overlay.h"
+#include <algorithm>
+#include <cstdio>
+
+const float ProfilerOverlay::GRAPH_WIDTH = 480.0f;
+const float ProfilerOverlay::GRAPH_HEIGHT = 120.0f;
+const float ProfilerOverlay::GRAPH_MAX_MS = 33.3f;
+// one frame at the window's 120 Hz limit
+const float ProfilerOverlay::TARGET_MS = 1000.0f / 120.0f;
+const unsigned ProfilerOverlay::REFRESH_FRAMES = 30;
+const unsigned ProfilerOverlay::CHARACTER_SIZE = 20;
+
+ProfilerOverlay::ProfilerOverlay() : graph(sf::LineStrip, Profiler::FRAME_HISTORY), targetLine(sf::Lines, 2),
+                                     lines(Profiler::MAX_ZONES + 1), lineCount(0), framesSinceRefresh(0) {
+    buffer.reserve(128);
+}
+/**
+ * Place the panel and set up every line it may show
+ * @return 0 if successfully initialized, 1 otherwise
+ */
+int ProfilerOverlay::init(const sf::Font& font, const sf::Vector2f& topLeft) {
+    position = topLeft;
+    float lineHeight = static_cast<float>(CHARACTER_SIZE) + 4.0f;
+    panel.setPosition(position);
+    panel.setSize(sf::Vector2f(GRAPH_WIDTH, GRAPH_HEIGHT));
+    panel.setFillColor(sf::Color(0, 0, 0, 160));
+
+    float targetY = position.y + GRAPH_HEIGHT * (1.0f - TARGET_MS / GRAPH_MAX_MS);
+    targetLine[0] = sf::Vertex(sf::Vector2f(position.x, targetY), sf::Color(255, 255, 0, 128));
+    targetLine[1] = sf::Vertex(sf::Vector2f(position.x + GRAPH_WIDTH, targetY), sf::Color(255, 255, 0, 128));
+
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        lines[i].setFont(font);
+        lines[i].setCharacterSize(CHARACTER_SIZE);
+        lines[i].setFillColor(sf::Color::White);
+        lines[i].setPosition(position.x + 6.0f, position.y + GRAPH_HEIGHT + 4.0f + lineHeight * static_cast<float>(i));
+    }
+    return 0;
+}
+
+/**
+ * Follow the last frame, call once per frame after Profiler::endFrame()
+ */
+void ProfilerOverlay::update(const Profiler& profiler) {
+    std::size_t frames = profiler.getFrameCount();
+    float step = GRAPH_WIDTH / static_cast<float>(Profiler::FRAME_HISTORY - 1);
+    for (std::size_t i = 0; i < Profiler::FRAME_HISTORY; ++i) {
+        // Newest frame on the right, the graph is flat until the history fills up
+        std::size_t age = Profiler::FRAME_HISTORY - 1 - i;
+        float ms = age < frames ? profiler.getFrameTime(frames - 1 - age) / 1000000.0f : 0.0f;
+        float height = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        graph[i].position = sf::Vector2f(position.x + step * static_cast<float>(i), position.y + GRAPH_HEIGHT - height);
+        graph[i].color = ms > TARGET_MS ? sf::Color::Red : sf::Color::Green;
+    }
+
+    if (framesSinceRefresh++ % REFRESH_FRAMES == 0) {
+        refreshLines(profiler);
+    }
+}
+/**
+ * Rebuild the texts from the last frame's tallies
+ */
+void ProfilerOverlay::refreshLines(const Profiler& profiler) {
+    char line[128];
+    std::size_t frames = profiler.getFrameCount();
+    float frameMs = frames > 0 ? profiler.getFrameTime(frames - 1) / 1000000.0f : 0.0f;
+    if (AllocTracker::isEnabled()) {
+        const AllocTracker::Counts& allocations = profiler.getFrameAllocations();
+        std::snprintf(line, sizeof(line), "frame %6.2f ms  %llu allocs  %llu bytes", frameMs,
+                      static_cast<unsigned long long>(allocations.allocations),
+                      static_cast<unsigned long long>(allocations.bytes));
+    } else {
+        std::snprintf(line, sizeof(line), "frame %6.2f ms", frameMs);
+    }
+    buffer.assign(line);
+    lines[0].setString(buffer);
+
+    const std::vector<Profiler::ZoneStats>& zones = profiler.getFrameZones();
+    lineCount = 1;
+    for (const auto& zone : zones) {
+        if (lineCount == lines.size()) {
+            break;
+        }
+        if (AllocTracker::isEnabled()) {
+            std::snprintf(line, sizeof(line), "%-28s %6.3f ms  x%-4u %llu allocs", zone.name,
+                          zone.total / 1000000.0, zone.calls, static_cast<unsigned long long>(zone.allocations));
+        } else {
+            std::snprintf(line, sizeof(line), "%-28s %6.3f ms  x%u", zone.name, zone.total / 1000000.0,
+                          zone.calls);
+        }
+        buffer.assign(line);
+        lines[lineCount++].setString(buffer);
+    }
+    // Panel grows with the number of zones
+    float lineHeight = static_cast<float>(CHARACTER_SIZE) + 4.0f;
+    panel.setSize(sf::Vector2f(GRAPH_WIDTH, GRAPH_HEIGHT + lineHeight * static_cast<float>(lineCount) + 8.0f));
+}
+/**
+ * Draw the panel, graph and texts
+ */
+void ProfilerOverlay::draw(sf::RenderTarget& target) const {
+    target.draw(panel);
+    target.draw(targetLine);
+    target.draw(graph);
+    for (std::size_t i = 0; i < lineCount; ++i) {
+        target.draw(lines[i]);
+    }
+}
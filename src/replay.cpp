@@ -0,0 +1,148 @@
+/*
+ * File: replay.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ReplayWriter and ReplayReader classes, record the seed and every
+ * tick's input of a session so it can be simulated again exactly.
+ */
+
+#include "replay.h"
+#include <cstring>
+
+const char Replay::MAGIC[4] = {'P', 'M', 'R', 'P'};
+// Bumped whenever a change to the simulation makes old replays play out differently
+const std::uint8_t Replay::VERSION = 6;
+// Inputs are the four direction bits
+const unsigned Replay::INPUT_BITS = 4;
+
+/**
+ * Writer destructor, makes sure the last run reaches the file
+ */
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+/**
+ * Start a new replay file
+ * @return 0 if the file could be written, 1 otherwise
+ */
+int ReplayWriter::open(const std::string& path, std::uint64_t seed, int worldScale) {
+    close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return 1;
+    }
+    file.write(Replay::MAGIC, sizeof(Replay::MAGIC));
+    file.put(static_cast<char>(Replay::VERSION));
+    for (unsigned i = 0; i < 8; ++i) {
+        file.put(static_cast<char>(seed >> (8 * i)));
+    }
+    file.put(static_cast<char>(worldScale));
+    runInput = 0;
+    runLength = 0;
+    ticks = 0;
+    return file ? 0 : 1;
+}
+/**
+ * Count the input towards the current run, starting a new run when it changes
+ */
+void ReplayWriter::record(std::uint8_t input) {
+    if (!file.is_open()) {
+        return;
+    }
+    input &= (1u << Replay::INPUT_BITS) - 1u;
+    if (runLength > 0 && input != runInput) {
+        writeRun();
+    }
+    runInput = input;
+    ++runLength;
+    ++ticks;
+}
+/**
+ * Write the pending run and close the file
+ */
+void ReplayWriter::close() {
+    if (!file.is_open()) {
+        return;
+    }
+    writeRun();
+    file.close();
+}
+/**
+ * Write the current run as a varint, seven bits per byte with the high bit
+ * set on every byte but the last
+ */
+void ReplayWriter::writeRun() {
+    if (runLength == 0) {
+        return;
+    }
+    std::uint64_t value = (runLength << Replay::INPUT_BITS) | runInput;
+    while (value >= 0x80) {
+        file.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    file.put(static_cast<char>(value));
+    runLength = 0;
+}
+
+
+/**
+ * Open a replay file and read its header
+ * @return 0 if it is a replay this version can play, 1 otherwise
+ */
+int ReplayReader::open(const std::string& path) {
+    file.open(path, std::ios::binary);
+    if (!file) {
+        return 1;
+    }
+    char magic[sizeof(Replay::MAGIC)];
+    file.read(magic, sizeof(magic));
+    int version = file.get();
+    if (!file || std::memcmp(magic, Replay::MAGIC, sizeof(magic)) != 0 || version != Replay::VERSION) {
+        return 1;
+    }
+    seed = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        int byte = file.get();
+        if (byte == std::char_traits<char>::eof()) {
+            return 1;
+        }
+        seed |= static_cast<std::uint64_t>(byte) << (8 * i);
+    }
+    worldScale = file.get();
+    if (worldScale == std::char_traits<char>::eof() || worldScale < 1) {
+        return 1;
+    }
+    runLeft = 0;
+    return 0;
+}
+/**
+ * Hand out the input of the next tick, reading a new run once the last one is used up
+ */
+bool ReplayReader::next(std::uint8_t& input) {
+    if (runLeft == 0 && !readRun()) {
+        return false;
+    }
+    --runLeft;
+    input = runInput;
+    return true;
+}
+/**
+ * Read one varint run, a truncated run ends the replay
+ */
+bool ReplayReader::readRun() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int byte = file.get();
+        if (byte == std::char_traits<char>::eof()) {
+            return false;
+        }
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            runInput = static_cast<std::uint8_t>(value & ((1u << Replay::INPUT_BITS) - 1u));
+            runLeft = value >> Replay::INPUT_BITS;
+            return runLeft > 0 || readRun();
+        }
+    }
+    return false;
+}
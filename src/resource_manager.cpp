@@ -0,0 +1,131 @@
+/*
+ * File: resource_manager.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: ResourceManager class, loads and validates every asset at startup
+ */
+
+#include "resource_manager.h"
+#include "entity.h"
+
+// Written next to the resources by the asset_baker target
+const char* const ResourceManager::BUNDLE_FILE = "resources/assets.bundle";
+
+const char* const ResourceManager::TEXTURE_FILES[TEXTURE_COUNT] = {
+        "resources/background.png",
+        "resources/pacman.png"
+};
+const char* const ResourceManager::SPRITE_FILES[SPRITE_COUNT] = {
+        "resources/blue.png",
+        "resources/orange.png",
+        "resources/pink.png",
+        "resources/red.png",
+        "resources/cherry.png",
+        "resources/melon.png",
+        "resources/berry.png"
+};
+const char* const ResourceManager::FONT_FILES[FONT_COUNT] = {
+        "resources/CyberpunkWaifus.ttf"
+};
+// Sizes things are drawn at: the background tiles at its own size, the player
+// is twice GameSim's 40 px radius, ghosts and fruits twice their hitbox
+const unsigned ResourceManager::TEXTURE_SIZES[TEXTURE_COUNT] = {0, 80};
+const unsigned ResourceManager::SPRITE_SIZES[SPRITE_COUNT] = {
+        static_cast<unsigned>(2 * GhostTraits::HITBOX),
+        static_cast<unsigned>(2 * GhostTraits::HITBOX),
+        static_cast<unsigned>(2 * GhostTraits::HITBOX),
+        static_cast<unsigned>(2 * GhostTraits::HITBOX),
+        static_cast<unsigned>(2 * FruitTraits::HITBOX),
+        static_cast<unsigned>(2 * FruitTraits::HITBOX),
+        static_cast<unsigned>(2 * FruitTraits::HITBOX)
+};
+
+/**
+ * Every file loadAll() looks for in the bundle, for the asset baker
+ */
+std::vector<ResourceManager::BakeItem> ResourceManager::getBakeList() {
+    std::vector<BakeItem> items;
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        items.push_back(BakeItem{TEXTURE_FILES[i], true, TEXTURE_SIZES[i]});
+    }
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        items.push_back(BakeItem{SPRITE_FILES[i], true, SPRITE_SIZES[i]});
+    }
+    for (int i = 0; i < FONT_COUNT; ++i) {
+        items.push_back(BakeItem{FONT_FILES[i], false, 0});
+    }
+    return items;
+}
+/**
+ * A baked image in the bundle, nullptr without a bundle or if it isn't in it
+ */
+const AssetBundle::Entry* ResourceManager::findImage(const char* path) const {
+    const AssetBundle::Entry* entry = bundle.isOpen() ? bundle.find(path) : nullptr;
+    return entry != nullptr && entry->width != 0 ? entry : nullptr;
+}
+const AssetBundle::Entry* ResourceManager::findFile(const char* path) const {
+    const AssetBundle::Entry* entry = bundle.isOpen() ? bundle.find(path) : nullptr;
+    return entry != nullptr && entry->width == 0 ? entry : nullptr;
+}
+
+/**
+ * Load every texture, sprite and font, carrying on past failures so they're all reported.
+ * Baked assets are uploaded straight from the mapped bundle, with nothing to decode.
+ * @return true if everything loaded, false otherwise
+ */
+bool ResourceManager::loadAll() {
+    sf::Clock clock;
+    errors.clear();
+    bundledCount = 0;
+    // Without a bundle (not baked, or baked by another build) every asset comes from its file
+    bundle.open(BUNDLE_FILE);
+
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        const AssetBundle::Entry* baked = findImage(TEXTURE_FILES[i]);
+        bool loaded;
+        if (baked != nullptr) {
+            loaded = textures[i].create(baked->width, baked->height);
+            if (loaded) {
+                textures[i].update(bundle.getData(*baked));
+                ++bundledCount;
+            }
+        } else {
+            loaded = textures[i].loadFromFile(TEXTURE_FILES[i]);
+        }
+        if (!loaded) {
+            errors.push_back(std::string("Failed to load texture ") + TEXTURE_FILES[i]);
+        }
+    }
+    textures[BACKGROUND].setRepeated(true);
+
+    sf::Image image;
+    for (int i = 0; i < SPRITE_COUNT; ++i) {
+        const AssetBundle::Entry* baked = findImage(SPRITE_FILES[i]);
+        if (baked != nullptr) {
+            image.create(baked->width, baked->height, bundle.getData(*baked));
+            ++bundledCount;
+        } else if (!image.loadFromFile(SPRITE_FILES[i])) {
+            errors.push_back(std::string("Failed to load sprite ") + SPRITE_FILES[i]);
+            // Keep a placeholder so every region id stays valid
+            image.create(1, 1, sf::Color::Transparent);
+        }
+        spriteRegions[i] = atlas.add(image);
+    }
+    if (!atlas.build()) {
+        errors.emplace_back("Failed to build the sprite atlas");
+    }
+
+    for (int i = 0; i < FONT_COUNT; ++i) {
+        // SFML reads the font from memory as glyphs are needed, the bundle stays mapped for that
+        const AssetBundle::Entry* baked = findFile(FONT_FILES[i]);
+        bool loaded = baked != nullptr
+                              ? fonts[i].loadFromMemory(bundle.getData(*baked), static_cast<std::size_t>(baked->size))
+                              : fonts[i].loadFromFile(FONT_FILES[i]);
+        bundledCount += baked != nullptr && loaded ? 1 : 0;
+        if (!loaded) {
+            errors.push_back(std::string("Failed to load font ") + FONT_FILES[i]);
+        }
+    }
+    loadTime = clock.getElapsedTime();
+    return errors.empty();
+}
@@ -0,0 +1,46 @@
+/*
+ * File: rewind_buffer.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: RewindBuffer class, keeps the last ticks of a game as flat save
+ * states to step back through
+ */
+
+#include "rewind_buffer.h"
+
+RewindBuffer::RewindBuffer(std::size_t capacity) : states(capacity), newest(capacity - 1), count(0) {
+}
+
+/**
+ * Reserve every state up front
+ */
+void RewindBuffer::reserve(const GameSim& sim) {
+    std::size_t size = sim.getMaxSaveSize();
+    for (SaveState& state : states) {
+        state.reserve(size);
+    }
+}
+
+/**
+ * Save the sim as the newest state, over the oldest one once the ring is full
+ */
+void RewindBuffer::push(const GameSim& sim) {
+    newest = (newest + 1) % states.size();
+    sim.save(states[newest]);
+    if (count < states.size()) {
+        ++count;
+    }
+}
+/**
+ * Restore the newest state and drop it, so the next pop goes one further back
+ * @return 0 if restored, 1 if the ring is empty
+ */
+int RewindBuffer::pop(GameSim& sim) {
+    if (count == 0) {
+        return 1;
+    }
+    int result = sim.restore(states[newest]);
+    newest = (newest + states.size() - 1) % states.size();
+    --count;
+    return result;
+}
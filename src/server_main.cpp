@@ -0,0 +1,118 @@
+/*
+ * File: server_main.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Headless game server, runs one shared game at the tick rate
+ * for the clients that join it over UDP, starting a new one after each ends.
+ */
+
+#include "net_server.h"
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage: game_server [options]\n"
+                 "  --port N           UDP port to listen on (default 5000)\n"
+                 "  --players N        player slots (default 4)\n"
+                 "  --seed N           seed of the first game (default random)\n"
+                 "  --world-scale N    world N screens wide and high (default 2)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned long port = 5000;
+    std::uint64_t seed = Rng::randomSeed();
+    SimConfig config;
+    config.players = 4;
+    config.worldScale = 2;
+
+    for (int i = 1; i < argc; ++i) {
+        try {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(std::string("unknown option or missing value ") + argv[i]);
+            } else if (std::strcmp(argv[i], "--port") == 0) {
+                port = std::stoul(argv[++i]);
+                if (port > 65535) {
+                    throw std::invalid_argument("--port must be below 65536");
+                }
+            } else if (std::strcmp(argv[i], "--players") == 0) {
+                config.players = std::stoi(argv[++i]);
+                if (config.players < 1 || config.players > 255) {
+                    throw std::invalid_argument("--players must be between 1 and 255");
+                }
+            } else if (std::strcmp(argv[i], "--seed") == 0) {
+                seed = std::stoull(argv[++i]);
+            } else if (std::strcmp(argv[i], "--world-scale") == 0) {
+                config.worldScale = std::stoi(argv[++i]);
+                if (config.worldScale < 1 || config.worldScale > 255) {
+                    throw std::invalid_argument("--world-scale must be between 1 and 255");
+                }
+            } else {
+                throw std::invalid_argument(std::string("unknown option ") + argv[i]);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    NetServer server(seed, config);
+    if (server.start(static_cast<unsigned short>(port)) != 0) {
+        std::cerr << "Could not listen on port " << port << std::endl;
+        return 1;
+    }
+    std::printf("listening on port %u, %d players, seed %llu\n", static_cast<unsigned>(server.getPort()), config.players,
+                static_cast<unsigned long long>(seed));
+
+    // Same pacing as the window's simulation thread: every tick that came due, then sleep
+    const sf::Time tickTime = GameSim::getTickTime();
+    const sf::Time restartDelay = sf::seconds(3);
+    const sf::Time reportInterval = sf::seconds(5);
+    sf::Clock clock;
+    sf::Time nextTick = tickTime;
+    sf::Time endedAt;
+    sf::Time nextReport = reportInterval;
+    std::uint64_t reportBytes = 0;
+    std::uint64_t reportStates = 0;
+    while (true) {
+        server.receive();
+        sf::Time now = clock.getElapsedTime();
+        if (now < nextTick) {
+            sf::sleep(std::min(nextTick - now, sf::milliseconds(1)));
+            continue;
+        }
+        // After a stall, skip ahead rather than run a burst of ticks
+        nextTick = std::max(nextTick, now - sf::milliseconds(250));
+        while (nextTick <= now) {
+            bool wasEnded = server.getSim().isGameEnded();
+            server.tick();
+            if (!wasEnded && server.getSim().isGameEnded()) {
+                endedAt = now;
+                std::printf("round %u over\n", static_cast<unsigned>(server.getRound()));
+            } else if (wasEnded && now - endedAt >= restartDelay) {
+                server.restart(Rng::randomSeed());
+            }
+            nextTick += tickTime;
+        }
+
+        if (now >= nextReport) {
+            std::uint64_t bytes = server.getStateBytes() - reportBytes;
+            std::uint64_t states = server.getStatesSent() - reportStates;
+            std::printf("%zu clients, %.1f bytes per tick per client\n", server.getClientCount(),
+                        states == 0 ? 0.0 : static_cast<double>(bytes) / static_cast<double>(states));
+            reportBytes = server.getStateBytes();
+            reportStates = server.getStatesSent();
+            nextReport += reportInterval;
+        }
+    }
+}
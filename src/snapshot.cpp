@@ -0,0 +1,46 @@
+/*
+ * File: snapshot.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: Snapshot struct, copies what the renderer needs out of the simulation.
+ */
+
+#include "snapshot.h"
+
+/**
+ * Reserve room for as many ghosts and fruits as the game can hold at once
+ */
+void Snapshot::reserve(const SimConfig& config) {
+    rivals.reserve(static_cast<std::size_t>(config.players));
+    ghosts.reserve(static_cast<std::size_t>(config.maxGhosts));
+    fruits.reserve(static_cast<std::size_t>(config.maxFruits));
+}
+/**
+ * Overwrite the snapshot with the simulation's current tick
+ */
+void Snapshot::capture(const GameSim& sim, sf::Time tickTime) {
+    tick = sim.getTickCount();
+    time = tickTime;
+    previousPlayerPosition = sim.getPreviousPlayerPosition();
+    playerPosition = sim.getPlayerPosition();
+    rivals.clear();
+    for (std::size_t i = 1; i < sim.getPlayerCount(); ++i) {
+        rivals.push_back(Sprite{sim.getPreviousPlayerPosition(i), sim.getPlayerPosition(i), static_cast<std::uint8_t>(i)});
+    }
+
+    const GhostStore& store = sim.getGhosts();
+    ghosts.clear();
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        ghosts.push_back(Sprite{store.getPreviousPosition(i), store.getPosition(i),
+                                static_cast<std::uint8_t>(store.getColor(i))});
+    }
+    fruits.clear();
+    for (const Fruit& fruit : sim.getFruits()) {
+        fruits.push_back(Sprite{fruit.getPosition(), fruit.getPosition(), static_cast<std::uint8_t>(fruit.getKind())});
+    }
+
+    score = sim.getScore();
+    timeLeft = sim.getTimeLeft();
+    speedBoosted = sim.isSpeedBoosted();
+    gameEnded = sim.isGameEnded();
+}
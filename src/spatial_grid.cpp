@@ -0,0 +1,179 @@
+/*
+ * File: spatial_grid.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: SpatialGrid class, incremental uniform grid used for collision
+ * and spawn clearance queries
+ */
+
+#include "spatial_grid.h"
+#include "collision.h"
+#include <algorithm>
+#include <cmath>
+
+const std::size_t SpatialGrid::MAX_CELL_RESERVE = 64;
+
+/**
+ * SpatialGrid constructor, positions outside the area go to the border cells
+ */
+SpatialGrid::SpatialGrid(float width, float height, float cellSize)
+        : cellSize(cellSize),
+          columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+          rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+          cells(static_cast<std::size_t>(columns) * rows) {
+}
+
+/**
+ * Size the id tables for every id and each cell for the whole crowd, up to MAX_CELL_RESERVE
+ */
+void SpatialGrid::reserve(std::size_t entities) {
+    if (entities > cellOf.size()) {
+        cellOf.resize(entities);
+        slotOf.resize(entities);
+    }
+    std::size_t perCell = std::min(entities, MAX_CELL_RESERVE);
+    for (auto& cell : cells) {
+        cell.ids.reserve(perCell);
+        cell.xs.reserve(perCell);
+        cell.ys.reserve(perCell);
+    }
+}
+
+int SpatialGrid::column(float x) const {
+    return std::min(std::max(static_cast<int>(x / cellSize), 0), columns - 1);
+}
+int SpatialGrid::row(float y) const {
+    return std::min(std::max(static_cast<int>(y / cellSize), 0), rows - 1);
+}
+std::uint32_t SpatialGrid::cellIndex(const sf::Vector2f& position) const {
+    return static_cast<std::uint32_t>(row(position.y) * columns + column(position.x));
+}
+
+
+/**
+ * Add an entity to the cell it stands in
+ */
+void SpatialGrid::insert(std::uint32_t id, const sf::Vector2f& position) {
+    if (id >= cellOf.size()) {
+        cellOf.resize(id + 1);
+        slotOf.resize(id + 1);
+    }
+    std::uint32_t index = cellIndex(position);
+    Cell& cell = cells[index];
+    cellOf[id] = index;
+    slotOf[id] = static_cast<std::uint32_t>(cell.ids.size());
+    cell.ids.push_back(id);
+    cell.xs.push_back(position.x);
+    cell.ys.push_back(position.y);
+}
+/**
+ * Update an entity's position, it only changes bucket when it crosses into another cell
+ */
+void SpatialGrid::move(std::uint32_t id, const sf::Vector2f& position) {
+    std::uint32_t index = cellIndex(position);
+    if (index == cellOf[id]) {
+        Cell& cell = cells[index];
+        cell.xs[slotOf[id]] = position.x;
+        cell.ys[slotOf[id]] = position.y;
+        return;
+    }
+    removeFromCell(id);
+    insert(id, position);
+}
+/**
+ * Remove an entity from the grid
+ */
+void SpatialGrid::remove(std::uint32_t id) {
+    removeFromCell(id);
+}
+/**
+ * Give an entity a new id, `to` must not be in the grid
+ */
+void SpatialGrid::rename(std::uint32_t from, std::uint32_t to) {
+    if (to >= cellOf.size()) {
+        cellOf.resize(to + 1);
+        slotOf.resize(to + 1);
+    }
+    cellOf[to] = cellOf[from];
+    slotOf[to] = slotOf[from];
+    cells[cellOf[to]].ids[slotOf[to]] = to;
+}
+/**
+ * Empty every cell, keeping their memory
+ */
+void SpatialGrid::clear() {
+    for (auto& cell : cells) {
+        cell.ids.clear();
+        cell.xs.clear();
+        cell.ys.clear();
+    }
+}
+/**
+ * Take an entity out of its cell, the last member of the cell fills the gap
+ */
+void SpatialGrid::removeFromCell(std::uint32_t id) {
+    Cell& cell = cells[cellOf[id]];
+    std::uint32_t slot = slotOf[id];
+    std::uint32_t last = static_cast<std::uint32_t>(cell.ids.size() - 1);
+    if (slot != last) {
+        cell.ids[slot] = cell.ids[last];
+        cell.xs[slot] = cell.xs[last];
+        cell.ys[slot] = cell.ys[last];
+        slotOf[cell.ids[slot]] = slot;
+    }
+    cell.ids.pop_back();
+    cell.xs.pop_back();
+    cell.ys.pop_back();
+}
+
+
+/**
+ * Find every entity closer than radius to center, looking only at the cells the circle overlaps
+ */
+void SpatialGrid::query(const sf::Vector2f& center, float radius, std::vector<std::uint32_t>& found) const {
+    found.clear();
+    int minColumn = column(center.x - radius);
+    int maxColumn = column(center.x + radius);
+    int minRow = row(center.y - radius);
+    int maxRow = row(center.y + radius);
+    for (int r = minRow; r <= maxRow; ++r) {
+        for (int c = minColumn; c <= maxColumn; ++c) {
+            const Cell& cell = cells[r * columns + c];
+            if (cell.ids.empty()) {
+                continue;
+            }
+            // The kernel writes cell slots straight into found, then they're turned into ids
+            std::size_t start = found.size();
+            found.resize(start + cell.ids.size());
+            std::size_t hitCount = Collision::findHits(cell.xs.data(), cell.ys.data(), cell.ids.size(),
+                                                       center.x, center.y, radius, found.data() + start);
+            for (std::size_t i = start; i < start + hitCount; ++i) {
+                found[i] = cell.ids[found[i]];
+            }
+            found.resize(start + hitCount);
+        }
+    }
+}
+/**
+ * Check if any entity is closer than radius to center
+ */
+bool SpatialGrid::anyWithin(const sf::Vector2f& center, float radius) const {
+    float radiusSq = radius * radius;
+    int minColumn = column(center.x - radius);
+    int maxColumn = column(center.x + radius);
+    int minRow = row(center.y - radius);
+    int maxRow = row(center.y + radius);
+    for (int r = minRow; r <= maxRow; ++r) {
+        for (int c = minColumn; c <= maxColumn; ++c) {
+            const Cell& cell = cells[r * columns + c];
+            for (std::size_t i = 0; i < cell.ids.size(); ++i) {
+                float dx = cell.xs[i] - center.x;
+                float dy = cell.ys[i] - center.y;
+                if (dx * dx + dy * dy < radiusSq) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
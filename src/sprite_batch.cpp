@@ -0,0 +1,50 @@
+/*
+ * File: sprite_batch.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: SpriteBatch class, builds the per-frame vertex array for ghosts and fruits
+ */
+
+#include "sprite_batch.h"
+
+/**
+ * SpriteBatch constructor, two triangles per sprite
+ */
+SpriteBatch::SpriteBatch() : vertices(sf::Triangles) {
+}
+/**
+ * Start a new frame
+ */
+void SpriteBatch::begin() {
+    vertices.clear();
+}
+/**
+ * Queue a sprite
+ */
+void SpriteBatch::add(const sf::Vector2f& position, float halfSize, const sf::IntRect& region) {
+    float left = position.x - halfSize;
+    float right = position.x + halfSize;
+    float top = position.y - halfSize;
+    float bottom = position.y + halfSize;
+
+    auto texLeft = static_cast<float>(region.left);
+    auto texRight = static_cast<float>(region.left + region.width);
+    auto texTop = static_cast<float>(region.top);
+    auto texBottom = static_cast<float>(region.top + region.height);
+
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(texLeft, texTop)));
+    vertices.append(sf::Vertex(sf::Vector2f(right, top), sf::Vector2f(texRight, texTop)));
+    vertices.append(sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(texRight, texBottom)));
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(texLeft, texTop)));
+    vertices.append(sf::Vertex(sf::Vector2f(right, bottom), sf::Vector2f(texRight, texBottom)));
+    vertices.append(sf::Vertex(sf::Vector2f(left, bottom), sf::Vector2f(texLeft, texBottom)));
+}
+/**
+ * Submit every queued sprite in one draw call
+ */
+void SpriteBatch::draw(sf::RenderTarget& target, const sf::Texture& texture) const {
+    if (vertices.getVertexCount() == 0) {
+        return;
+    }
+    target.draw(vertices, sf::RenderStates(&texture));
+}
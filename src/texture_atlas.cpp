@@ -0,0 +1,63 @@
+/*
+ * File: texture_atlas.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: TextureAtlas class, row packing of the entity images into one texture
+ */
+
+#include "texture_atlas.h"
+#include <algorithm>
+
+const unsigned TextureAtlas::PADDING = 2;
+
+/**
+ * Queue an image to be packed
+ * @return the region id to draw it with once built
+ */
+int TextureAtlas::add(const sf::Image& image) {
+    images.push_back(image);
+    regions.emplace_back();
+    return static_cast<int>(images.size() - 1);
+}
+/**
+ * Place the images left to right, starting a new row when the current one would
+ * go past the largest texture the GPU allows, then upload the result
+ * @return true if successfully built, false otherwise
+ */
+bool TextureAtlas::build() {
+    const unsigned rowWidth = sf::Texture::getMaximumSize();
+
+    unsigned x = 0;
+    unsigned y = 0;
+    unsigned rowHeight = 0;
+    unsigned atlasWidth = 0;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        sf::Vector2u size = images[i].getSize();
+        if (x > 0 && x + size.x + PADDING > rowWidth) {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        regions[i] = sf::IntRect(x, y, size.x, size.y);
+        x += size.x + PADDING;
+        rowHeight = std::max(rowHeight, size.y + PADDING);
+        atlasWidth = std::max(atlasWidth, x);
+    }
+    unsigned atlasHeight = y + rowHeight;
+    if (atlasWidth == 0 || atlasWidth > rowWidth || atlasHeight > rowWidth) {
+        return false;
+    }
+
+    sf::Image atlas;
+    atlas.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        atlas.copy(images[i], regions[i].left, regions[i].top);
+    }
+    // The CPU copies aren't needed once uploaded
+    images.clear();
+    if (!texture.loadFromImage(atlas)) {
+        return false;
+    }
+    texture.setSmooth(true);
+    return true;
+}
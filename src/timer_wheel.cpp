@@ -0,0 +1,84 @@
+/*
+ * File: timer_wheel.cpp
+ * Author: Alejandro Gutierrez Acosta [11acc], Katherine Duque, Rama Mallela
+ * Date: Oct 18 2026
+ * Description: TimerWheel class, schedules game events by tick.
+ */
+
+#include "timer_wheel.h"
+#include <algorithm>
+
+// 1024 ticks is 8.5 seconds at 120 Hz, longer than any ghost or spawn delay
+const std::size_t TimerWheel::DEFAULT_SLOTS = 1024;
+
+/**
+ * TimerWheel constructor, the slot count is rounded up to a power of two
+ */
+TimerWheel::TimerWheel(std::size_t slotCount, std::size_t capacity)
+        : nodes(capacity), count(0), currentTick(0), clears(0) {
+    std::size_t size = 1;
+    while (size < slotCount) {
+        size <<= 1u;
+    }
+    slots.resize(size);
+    mask = size - 1;
+}
+
+/**
+ * Add a timer, it fires when advance() reaches its tick
+ */
+void TimerWheel::schedule(const Timer& timer) {
+    std::uint32_t node = nodes.acquire();
+    if (node == Pool<Node>::NONE) {
+        nodes.reserve(std::max<std::size_t>(nodes.capacity() * 2, 16));
+        node = nodes.acquire();
+    }
+    nodes[node].timer = timer;
+    if (timer.tick <= currentTick) {
+        nodes[node].timer.tick = currentTick + 1;
+    }
+    append(nodes[node].timer.tick & mask, node);
+    ++count;
+}
+/**
+ * Link a node at the end of a slot's list
+ */
+void TimerWheel::append(std::size_t slot, std::uint32_t node) {
+    nodes[node].next = Pool<Node>::NONE;
+    List& list = slots[slot];
+    if (list.tail == Pool<Node>::NONE) {
+        list.head = node;
+    } else {
+        nodes[list.tail].next = node;
+    }
+    list.tail = node;
+}
+/**
+ * Drop every timer, keeping the pool's memory
+ */
+void TimerWheel::clear() {
+    nodes.clear();
+    for (auto& slot : slots) {
+        slot = List();
+    }
+    count = 0;
+    ++clears;
+}
+/**
+ * Copy out the nodes and the slots' lists, which link nodes by index
+ */
+void TimerWheel::save(SaveState& state) const {
+    nodes.save(state);
+    state.writeVector(slots);
+    state.write(count);
+    state.write(currentTick);
+}
+/**
+ * Copy them back, the wheel must have the slot count it was saved with
+ */
+void TimerWheel::restore(const SaveState& state, std::size_t& offset) {
+    nodes.restore(state, offset);
+    state.readVector(offset, slots);
+    state.read(offset, count);
+    state.read(offset, currentTick);
+}